@@ -0,0 +1,140 @@
+/*
+  Example Sketch: Replay a Recorded Input Trace and Benchmark update()
+
+  Code Prompt:
+    Measure how many button updates per second this board can run, with
+    no buttons wired at all, and get the same event counts on every run:
+      • A recorded press/bounce/hold trace replaces the real inputs
+      • A simulated clock replaces millis(), so the trace runs faster than real time
+      • The same trace is replayed through 1, 16 and 256 buttons
+
+  Implementation Overview:
+    1. TraceInput is an OptaInputProvider: readChannel() looks the current
+       simulated time up in the trace (each channel starts a little later,
+       so the buttons don't all move together)
+    2. simulatedClock() is handed to optaButtonUseClock()
+    3. For each button count:
+         • create the buttons on the provider and begin() them
+         • step the simulated clock one scan at a time, update() every button
+         • time the whole run with the real micros() clock
+    4. Print updates per second and the event counts
+
+  How to Use:
+    • Upload and open the Serial Monitor at 115200 baud
+    • Compare updates/s between boards, build flags or library versions
+    • Event counts depend only on the trace and the button settings, so
+      they must match from run to run (handy for checking acceleration curves)
+    • AVR boards run 1 and 16 buttons only (256 buttons won't fit in 2 KB)
+
+  The sketch only uses the Arduino API and OptaButton, so it also builds
+  for host-side (desktop) Arduino cores.
+*/
+
+#include <OptaButton.h>  // OptaButton library, OptaInputProvider, optaButtonUseClock()
+
+// ---------- The recorded trace ----------
+// One press with contact bounce, a 2.5 s hold, and a bouncy release
+struct TraceStep {
+  uint16_t atMs;  // time into the trace
+  bool pressed;   // input level from then on
+};
+const TraceStep trace[] = {
+  { 0, false },
+  { 100, true }, { 101, false }, { 103, true }, { 104, false }, { 106, true },  // press bounce
+  { 2600, false }, { 2602, true }, { 2603, false },                            // release bounce
+  { 3000, true }, { 3150, false },                                            // a quick tap
+};
+const uint8_t TRACE_STEPS = sizeof(trace) / sizeof(trace[0]);
+const uint16_t TRACE_PERIOD_MS = 4000;  // the trace repeats after this
+const uint32_t RUN_MS = 20000;          // simulated time per benchmark run
+
+// ---------- Simulated clock ----------
+uint32_t simulatedNow = 0;  // in ticks of the active timebase
+uint32_t simulatedClock() {
+  return simulatedNow;
+}
+
+// ---------- Input provider that replays the trace ----------
+class TraceInput : public OptaInputProvider {
+public:
+  bool readChannel(uint8_t channel) override {
+    uint32_t ms = simulatedNow / OPTA_BUTTON_TICKS_PER_MS;            // simulated ms
+    uint16_t t = uint16_t((ms + channel * 37UL) % TRACE_PERIOD_MS);  // stagger the channels
+    bool level = false;                                               // before the first step
+    for (uint8_t i = 0; i < TRACE_STEPS && trace[i].atMs <= t; i++) {
+      level = trace[i].pressed;  // latest step at or before t
+    }
+    return level;
+  }
+};
+TraceInput traceInput;
+
+// ---------- Benchmark ----------
+#if defined(ARDUINO_ARCH_AVR)
+const uint16_t buttonCounts[] = { 1, 16 };
+#else
+const uint16_t buttonCounts[] = { 1, 16, 256 };
+#endif
+const uint16_t MAX_BUTTONS = buttonCounts[sizeof(buttonCounts) / sizeof(buttonCounts[0]) - 1];
+OptaButton* buttons[MAX_BUTTONS];
+
+void runBenchmark(uint16_t count) {
+  // Create the buttons on the trace provider (channel = index)
+  for (uint16_t i = 0; i < count; i++) {
+    buttons[i] = new OptaButton(traceInput, uint8_t(i), "bench");
+    buttons[i]->begin();
+  }
+
+  // Replay the trace, one scan interval per step
+  uint32_t shortPresses = 0, longPresses = 0, repeats = 0, releases = 0;
+  uint32_t updates = 0;
+  simulatedNow = 0;
+  uint32_t startUs = micros();  // real time
+  while (simulatedNow < RUN_MS * OPTA_BUTTON_TICKS_PER_MS) {
+    simulatedNow += LOOP_INTERVAL_TICKS;  // advance simulated time by one scan
+    for (uint16_t i = 0; i < count; i++) {
+      OptaButton& b = *buttons[i];
+      b.update();
+      shortPresses += b.isShortPressed();
+      longPresses += b.isLongPressed();
+      repeats += b.isRepeating();
+      releases += b.isReleased();
+    }
+    updates += count;
+  }
+  uint32_t elapsedUs = micros() - startUs;
+
+  // Report
+  Serial.print("buttons=");
+  Serial.print(count);
+  Serial.print(" updates/s=");
+  Serial.print(uint32_t(updates * 1000000.0 / (elapsedUs ? elapsedUs : 1)));
+  Serial.print(" short=");
+  Serial.print(shortPresses);
+  Serial.print(" long=");
+  Serial.print(longPresses);
+  Serial.print(" repeat=");
+  Serial.print(repeats);
+  Serial.print(" release=");
+  Serial.println(releases);
+
+  for (uint16_t i = 0; i < count; i++) {
+    delete buttons[i];  // make room for the next run
+  }
+}
+
+void setup() {
+  Serial.begin(115200);  // check baudrate against monitor
+  delay(500);            // small delay so the Serial Monitor can attach after reset
+
+  optaButtonUseClock(simulatedClock);  // every button now runs on simulated time
+  for (uint8_t n = 0; n < sizeof(buttonCounts) / sizeof(buttonCounts[0]); n++) {
+    runBenchmark(buttonCounts[n]);
+  }
+  optaButtonUseClock(nullptr);  // back to the hardware clock
+  Serial.println("Done.");
+}
+
+void loop() {
+  // Nothing to do: the benchmark runs once in setup()
+}
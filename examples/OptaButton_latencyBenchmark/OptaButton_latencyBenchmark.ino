@@ -0,0 +1,338 @@
+/*
+  Example Sketch: Hardware-in-the-Loop Press-to-Event Latency Benchmark
+
+  Code Prompt:
+    Get hard numbers for how long it takes from an input changing to the
+    sketch seeing the event, on real hardware and real inputs:
+      • An output pin is wired back to a button input
+      • The sketch toggles that output and timestamps the resulting OptaButton events
+      • Press and release latency are reported as p50 / p99 / max plus a histogram
+      • Scan cost (update() time per button) and scan jitter are reported too
+      • The same run repeats for several button counts
+
+  Implementation Overview:
+    1. Pick the input mode, the pins and the scan mode in the settings below:
+         SCAN_BUTTONS  – each button's own update()
+         SCAN_GROUP    – one OptaButtonGroup::update()
+         SCAN_IRQ      – the group, with the measured button on useInterrupts()
+         SCAN_THREAD   – OptaButtonThread (Opta only), events from waitEvent()
+    2. For each button count, create that many buttons on the same input
+       (so every one of them really reads and really fires; button 0 is
+       the one that is timed) and begin() them
+    3. Every trial:
+         • wait a pseudo-random time, so the edge lands anywhere in the scan period
+         • drive the output active, note micros(), scan until button 0 reports SHORT_PRESS
+         • hold, then drive it inactive and scan until it reports RELEASE
+    4. Scans run at a fixed SCAN_PERIOD_US through update(nowTicks), so
+       each one can be timed (cost) and its start compared with the
+       schedule (jitter)
+    5. Print the report, one block per button count
+
+  How to Use:
+    • Wire DRIVE_PIN to the input under test:
+        – GPIO (Uno/Mega): a wire from DRIVE_PIN to INPUT_PIN; the output pulls LOW = pressed
+        – OPTA_CTL / EXP_DIG: switch +24 V into the input from an output (relay or
+          solid-state); the figures then include the output's own switching time,
+          so measure that once with a scope and subtract it
+    • Upload and open the Serial Monitor at 115200 baud
+    • Rerun after library or build-flag changes: p99 and max are the numbers to watch
+    • Debounce is IMMEDIATE here, so the press is reported on the first edge;
+      change BENCH_DEBOUNCE to compare STABLE or INTEGRATOR latency
+
+  Reading the report:
+    press / release  – input change to event seen by the sketch, in µs
+    cost             – µs of update() per button per scan (average and worst scan)
+    jitter           – how late a scan started versus its schedule (worst case)
+    timeouts         – trials where no event came within a second (check the wiring)
+    bytes            – sizeof(OptaButton) and sizeof(OptaButtonGroup) in this build;
+                       a run that does not fit in RAM is reported and skipped
+*/
+
+#include <new>                  // std::nothrow: a failed allocation returns nullptr
+#include <OptaButtonGroup.h>    // OptaButton library plus the batch poller
+using DefLab::ButtonInputMode;  // alias the shared enum so we can write ButtonInputMode::GPIO, etc
+#if defined(ARDUINO_ARCH_MBED)
+#include <OptaButtonThread.h>  // scanner thread (SCAN_THREAD)
+#endif
+
+// ---------- Settings ----------
+#define SCAN_BUTTONS 0
+#define SCAN_GROUP 1
+#define SCAN_IRQ 2
+#define SCAN_THREAD 3
+#define SCAN_MODE SCAN_GROUP  // which scan to benchmark (see above)
+
+const ButtonInputMode BENCH_MODE = ButtonInputMode::GPIO;  // GPIO, OPTA_CTL or EXP_DIG
+const uint8_t INPUT_PIN = 2;    // pin (GPIO / OPTA_CTL) or expansion channel (EXP_DIG) under test
+const uint8_t DRIVE_PIN = 7;    // output wired back to that input
+const OptaDebounceMode BENCH_DEBOUNCE = OptaDebounceMode::IMMEDIATE;
+const uint16_t SCAN_PERIOD_US = 1000;  // one scan per ms, like update()'s own gate
+const uint32_t TIMEOUT_US = 1000000;   // give up on a trial after a second
+
+#if defined(ARDUINO_ARCH_AVR)
+const uint8_t buttonCounts[] = { 1, 8 };  // 2 KB of SRAM: keep it small
+const uint8_t TRIALS = 32;
+#else
+const uint8_t buttonCounts[] = { 1, 4, 16, 32 };
+const uint8_t TRIALS = 200;
+#endif
+const uint8_t RUNS = sizeof(buttonCounts) / sizeof(buttonCounts[0]);
+
+// Pressed level on the drive pin: GPIO inputs are active-LOW, Opta inputs active-HIGH
+const uint8_t DRIVE_ACTIVE = (BENCH_MODE == ButtonInputMode::GPIO) ? LOW : HIGH;
+const uint8_t DRIVE_IDLE = (DRIVE_ACTIVE == LOW) ? HIGH : LOW;
+
+// ---------- Run State ----------
+OptaButton* buttons[OPTA_BUTTON_GROUP_MAX];  // button 0 is timed, the rest add load
+OptaButtonGroup* group = nullptr;            // SCAN_GROUP / SCAN_IRQ / SCAN_THREAD
+#if defined(ARDUINO_ARCH_MBED) && SCAN_MODE == SCAN_THREAD
+OptaButtonThread* scanner = nullptr;
+#endif
+uint8_t count = 0;  // buttons in this run
+
+uint32_t pressUs[TRIALS];    // latency samples
+uint32_t releaseUs[TRIALS];  //
+uint8_t timeouts = 0;
+
+uint32_t nextScanUs = 0;     // when the next scan is due
+uint32_t scans = 0;          // scans timed
+uint32_t scanTotalUs = 0;    // their total cost
+uint32_t scanMaxUs = 0;      // the worst one
+uint32_t lateMaxUs = 0;      // worst start after schedule
+
+// Small LCG, so every board gets the same trial timing
+uint32_t rngState = 12345;
+uint16_t nextRandom(uint16_t range) {
+  rngState = rngState * 1103515245UL + 12345UL;
+  return uint16_t((rngState >> 16) % range);
+}
+
+// ---------- Scanning ----------
+// One scheduled scan, if one is due; returns true if it ran
+bool scanIfDue() {
+#if SCAN_MODE == SCAN_THREAD
+  return false;  // the scanner thread does its own
+#else
+  uint32_t now = micros();
+  if (int32_t(now - nextScanUs) < 0) return false;  // not yet
+  uint32_t late = now - nextScanUs;                 // how far behind the schedule we started
+  if (late > lateMaxUs) lateMaxUs = late;
+  nextScanUs += SCAN_PERIOD_US;
+  if (int32_t(now - nextScanUs) >= 0) nextScanUs = now + SCAN_PERIOD_US;  // fell a whole period behind: resync
+
+  uint32_t ticks = optaButtonNow();  // one clock read for the whole scan
+  uint32_t startUs = micros();
+#if SCAN_MODE == SCAN_BUTTONS
+  for (uint8_t i = 0; i < count; i++) buttons[i]->update(ticks);
+#else
+  group->update(ticks);
+#endif
+  uint32_t us = micros() - startUs;
+  scanTotalUs += us;
+  if (us > scanMaxUs) scanMaxUs = us;
+  scans++;
+  return true;
+#endif
+}
+
+// Keep scanning for a while (settling between trials)
+void scanFor(uint32_t us) {
+  uint32_t start = micros();
+  while (micros() - start < us) {
+#if SCAN_MODE == SCAN_THREAD
+    OptaButtonEvent ev;
+    while (scanner->pollEvent(ev)) {
+      // drain: only events after the next edge count
+    }
+    delay(1);
+#else
+    scanIfDue();
+#endif
+  }
+}
+
+// Drive the input and time how long until button 0 reports the event
+uint32_t measure(uint8_t level, OptaButtonEventType type) {
+  uint32_t t0 = micros();
+  digitalWrite(DRIVE_PIN, level);  // the edge under test
+  while (micros() - t0 < TIMEOUT_US) {
+#if SCAN_MODE == SCAN_THREAD
+    OptaButtonEvent ev;
+    if (scanner->waitEvent(ev, 1) && ev.buttonId == 0 && ev.type == type) return micros() - t0;
+#else
+    if (!scanIfDue()) continue;
+    bool seen = (type == OptaButtonEventType::SHORT_PRESS) ? buttons[0]->isShortPressed() : buttons[0]->isReleased();
+    if (seen) return micros() - t0;
+#endif
+  }
+  timeouts++;
+  return TIMEOUT_US;
+}
+
+// ---------- Report ----------
+void sortSamples(uint32_t* s, uint8_t n) {
+  for (uint8_t i = 1; i < n; i++) {  // insertion sort: n is small
+    uint32_t v = s[i];
+    uint8_t j = i;
+    while (j > 0 && s[j - 1] > v) {
+      s[j] = s[j - 1];
+      j--;
+    }
+    s[j] = v;
+  }
+}
+
+void printLatency(const char* name, uint32_t* s) {
+  sortSamples(s, TRIALS);
+  Serial.print(name);
+  Serial.print(" us p50=");
+  Serial.print(s[(TRIALS - 1) * 50 / 100]);
+  Serial.print(" p99=");
+  Serial.print(s[(TRIALS - 1) * 99 / 100]);
+  Serial.print(" max=");
+  Serial.println(s[TRIALS - 1]);
+
+  // Histogram in power-of-two buckets: "<  1024 us ####"
+  uint8_t i = 0;
+  for (uint32_t limit = 128; i < TRIALS; limit *= 2) {
+    uint8_t n = 0;
+    while (i < TRIALS && s[i] < limit) {
+      n++;
+      i++;
+    }
+    if (!n) continue;
+    Serial.print("  < ");
+    Serial.print(limit);
+    Serial.print(" us ");
+    for (uint8_t b = 0; b < n; b += (TRIALS > 64 ? 4 : 1)) Serial.print('#');  // long runs: one # per 4
+    Serial.print(' ');
+    Serial.println(n);
+  }
+}
+
+// ---------- Free One Run ----------
+void freeRun() {
+#if defined(ARDUINO_ARCH_MBED) && SCAN_MODE == SCAN_THREAD
+  delete scanner;
+  scanner = nullptr;
+#endif
+  delete group;
+  group = nullptr;
+  for (uint8_t i = 0; i < count; i++) delete buttons[i];
+  count = 0;
+}
+
+// ---------- One Benchmark Run ----------
+void runBenchmark(uint8_t n) {
+  // Every button reads the same input; button 0 is the one we time
+  count = 0;
+  while (count < n) {
+    buttons[count] = new (std::nothrow) OptaButton(BENCH_MODE, INPUT_PIN, "bench", 20, false, 800, 100, 8, 100, BENCH_DEBOUNCE);
+    if (!buttons[count]) break;  // out of RAM: stop here, report below
+    count++;
+  }
+#if SCAN_MODE != SCAN_BUTTONS
+  if (count == n) group = new (std::nothrow) OptaButtonGroup(buttons, count);
+#endif
+#if SCAN_MODE == SCAN_THREAD
+  if (group) scanner = new (std::nothrow) OptaButtonThread(*group);
+  bool allocated = scanner != nullptr;
+#elif SCAN_MODE != SCAN_BUTTONS
+  bool allocated = group != nullptr;
+#else
+  bool allocated = count == n;
+#endif
+  if (!allocated) {
+    Serial.print("buttons=");
+    Serial.print(n);
+    Serial.print(" skipped: out of RAM after ");
+    Serial.print(count);
+    Serial.println(" buttons");
+    Serial.println();
+    freeRun();
+    return;
+  }
+#if SCAN_MODE == SCAN_BUTTONS
+  for (uint8_t i = 0; i < count; i++) buttons[i]->begin();
+#else
+  group->begin();
+#endif
+#if SCAN_MODE == SCAN_IRQ
+  if (!buttons[0]->useInterrupts()) Serial.println("interrupts not available on this pin/mode: polling");
+#endif
+#if SCAN_MODE == SCAN_THREAD
+  scanner->start(SCAN_PERIOD_US / 1000 ? SCAN_PERIOD_US / 1000 : 1);
+#endif
+
+  // Trials
+  scans = scanTotalUs = scanMaxUs = lateMaxUs = 0;
+  timeouts = 0;
+  nextScanUs = micros();
+  for (uint8_t t = 0; t < TRIALS; t++) {
+    scanFor(50000UL + nextRandom(SCAN_PERIOD_US));  // released and settled, random phase
+    pressUs[t] = measure(DRIVE_ACTIVE, OptaButtonEventType::SHORT_PRESS);
+    scanFor(50000UL + nextRandom(SCAN_PERIOD_US));  // held past the debounce
+    releaseUs[t] = measure(DRIVE_IDLE, OptaButtonEventType::RELEASE);
+  }
+
+  // Report
+  Serial.print("buttons=");
+  Serial.print(count);
+  Serial.print(" trials=");
+  Serial.print(TRIALS);
+  Serial.print(" timeouts=");
+  Serial.println(timeouts);
+  printLatency("press  ", pressUs);
+  printLatency("release", releaseUs);
+#if SCAN_MODE != SCAN_THREAD
+  uint32_t perButton = scans ? scanTotalUs * 100UL / scans / count : 0;  // hundredths of a µs
+  Serial.print("cost    us/button avg=");
+  Serial.print(perButton / 100);
+  Serial.print(perButton % 100 < 10 ? ".0" : ".");
+  Serial.print(perButton % 100);
+  Serial.print(" worst scan=");
+  Serial.print(scanMaxUs);
+  Serial.print(" jitter max=");
+  Serial.println(lateMaxUs);
+#else
+  Serial.print("dropped=");
+  Serial.println(scanner->getDropped());  // scan cost: build with OPTA_BUTTON_STATS=1
+  scanner->stop();
+#endif
+  Serial.println();
+
+  // Make room for the next run
+  freeRun();
+}
+
+// ---------- SETUP ----------
+void setup() {
+  Serial.begin(115200);  // check baudrate against monitor
+  delay(500);            // small delay so the Serial Monitor can attach after reset
+
+  OPTA_BEGIN();  // Opta core and expansions (no-op on AVR)
+  pinMode(DRIVE_PIN, OUTPUT);
+  digitalWrite(DRIVE_PIN, DRIVE_IDLE);  // start released
+
+  static const char* const scanNames[] = { "buttons", "group", "group+irq", "thread" };
+  Serial.print("OptaButton latency benchmark: mode=");
+  Serial.print(BENCH_MODE == ButtonInputMode::GPIO ? "GPIO" : (BENCH_MODE == ButtonInputMode::OPTA_CTL ? "OPTA_CTL" : "EXP_DIG"));
+  Serial.print(" scan=");
+  Serial.print(scanNames[SCAN_MODE]);
+  Serial.print(" periodUs=");
+  Serial.println(SCAN_PERIOD_US);
+  Serial.print("bytes   button=");
+  Serial.print(sizeof(OptaButton));  // what each extra button costs in this build
+  Serial.print(" group=");
+  Serial.println(sizeof(OptaButtonGroup));
+  Serial.println();
+
+  for (uint8_t r = 0; r < RUNS; r++) {
+    runBenchmark(buttonCounts[r]);
+  }
+  Serial.println("Done.");
+}
+
+void loop() {
+  // Nothing to do: the benchmark runs once in setup()
+}
@@ -147,6 +147,15 @@ bool programMode = false;  // start with editing disabled
 // Currently selected menu item (this value is used as an index into the arrays)
 Settings currentSetting = SETTING_VOLUME;  // start with Volume selected
 
+// How far one UP / DOWN repeat moves the selected value: repeatStep() gives 1, then
+// 10 and 100 on a long hold; cap it at a tenth of the setting's range so a 0-100
+// setting still moves in steps you can see instead of jumping to its limit
+int stepSize(uint16_t step) {
+  int cap = (settingMax[currentSetting] - settingMin[currentSetting]) / 10;  // 10 for 0-100, 25 for 0-255
+  if (cap < 1) cap = 1;                                                      // small ranges still move by 1
+  return (int(step) < cap) ? int(step) : cap;                                // the smaller of the two
+}
+
 // ---------- SETUP ----------
 
 void setup() {
@@ -207,8 +216,8 @@ void loop() {
 
   // 4] Check for UP button to increase the selected value with repeat
 
-  if (btnUp.isShortPressed() || btnUp.isRepeating()) {  // either a tap OR an auto-repeat tick while holding
-    settingValues[currentSetting]++;                    // increase the current setting by 1
+  if (btnUp.isShortPressed() || btnUp.isRepeating()) {              // either a tap OR an auto-repeat tick while holding
+    settingValues[currentSetting] += stepSize(btnUp.repeatStep());  // +1 per tap, more once UP has been held a while
 
     // Clamp the value so it never goes below min or above max for that setting
     settingValues[currentSetting] = constrain(  // constrain(x, min, max) returns a clamped value
@@ -239,8 +248,8 @@ void loop() {
 
   // 5] Check for DOWN button to decrease the selected value with repeat
 
-  if (btnDown.isShortPressed() || btnDown.isRepeating()) {  // either a tap OR an auto-repeat tick while holding
-    settingValues[currentSetting]--;                        // decrease the current setting by 1
+  if (btnDown.isShortPressed() || btnDown.isRepeating()) {            // either a tap OR an auto-repeat tick while holding
+    settingValues[currentSetting] -= stepSize(btnDown.repeatStep());  // -1 per tap, more once DOWN has been held a while
 
     // Clamp the value so it stays inside its allowed range
     settingValues[currentSetting] = constrain(  // clamp again after decrement
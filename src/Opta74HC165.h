@@ -0,0 +1,77 @@
+/*
+  NAME:
+    Opta74HC165 — Chain of 74HC165 shift registers as one bulk input
+
+  Purpose
+  Each 74HC165 adds 8 inputs for three shared wires (latch, clock, data).
+  One latch pulse and one SPI burst read the whole chain per scan.
+
+  Wiring
+    • SH/LD (pin 1) of every chip to latchPin
+    • CLK (pin 2) of every chip to SCK, CLK INH (pin 15) to GND
+    • QH (pin 9) of the first chip to MISO; each later chip's QH to the
+      previous chip's SER (pin 10); the last chip's SER to GND
+    • Buttons from D0-D7 to GND with 10 k pull-ups (active-LOW, the default)
+  Channel 0-7 are D0-D7 of the chip on MISO, 8-15 the next one, and so on.
+
+  How to Use
+    Opta74HC165 keys(10, 4);             // latch on pin 10, 4 chips = 32 inputs
+    OptaButton btnStart(keys, 0, "Start");
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <SPI.h>            // SPI bus
+#include "OptaBulkInput.h"  // snapshot bookkeeping
+
+class Opta74HC165 : public OptaBulkInput {
+public:
+  // ---------- Constructor ----------
+  Opta74HC165(
+    uint8_t latchPin,           // SH/LD of every chip
+    uint8_t chips = 1,          // chips in the chain (8 channels each, up to 8)
+    bool activeLow = true,      // buttons pull the inputs to GND
+    uint32_t clockHz = 4000000  // SPI clock; lower it for long cables
+  );                            // end constructor
+
+protected:
+  void beginBus() override;                 // latch pin and SPI
+  void readBurst(uint8_t* bytes) override;  // latch, then one SPI transfer of the chain
+
+private:
+  const uint8_t latch;   // SH/LD pin
+  const uint8_t length;  // chips in the chain (bytes per burst)
+  const uint32_t speed;  // SPI clock
+};
+
+// Defined here, not in a .cpp: only sketches that include this header pull in SPI
+
+// ---------- Constructor ----------
+inline Opta74HC165::Opta74HC165(uint8_t latchPin, uint8_t chips, bool activeLow, uint32_t clockHz)
+  : OptaBulkInput(uint8_t((chips > 8 ? 8 : chips) * 8), activeLow),  // 8 channels per chip
+    latch(latchPin),                                                  // save the latch pin
+    length(chips > 8 ? 8 : chips),                                    // never more than the snapshot holds
+    speed(clockHz)                                                    // save the clock
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- beginBus() ----------
+inline void Opta74HC165::beginBus() {
+  pinMode(latch, OUTPUT);
+  digitalWrite(latch, HIGH);  // idle = shift mode
+  SPI.begin();
+}
+
+// ---------- readBurst() ----------
+inline void Opta74HC165::readBurst(uint8_t* bytes) {
+  digitalWrite(latch, LOW);   // load D0-D7 of every chip at once
+  digitalWrite(latch, HIGH);  // back to shift mode (the pulse is far longer than the 20 ns needed)
+  SPI.beginTransaction(SPISettings(speed, MSBFIRST, SPI_MODE0));
+  for (uint8_t i = 0; i < length; i++) {
+    bytes[i] = SPI.transfer(0);  // D7 comes out first, so bit n = Dn
+  }
+  SPI.endTransaction();
+}
+
+// Opta74HC165.h
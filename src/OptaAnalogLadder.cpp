@@ -0,0 +1,72 @@
+/*
+ * OptaAnalogLadder.cpp
+ * One analog conversion per scan, decoded into a key number
+ */
+
+#include "OptaAnalogLadder.h"  // include our header
+
+// Constructor implementation
+OptaAnalogLadder::OptaAnalogLadder(uint8_t analogPin, const uint16_t* levels, uint8_t count,
+                                   uint16_t tolerance, uint16_t hysteresis)
+  : pin(analogPin),                                                        // save the input
+    table(levels),                                                         // save the table
+    keyCount(count > OPTA_LADDER_MAX_KEYS ? OPTA_LADDER_MAX_KEYS : count),  // never more than the mask holds
+    window(tolerance),                                                     // save tolerance
+    stickiness(hysteresis),                                                // save hysteresis
+    readMask(0xFFFF),                                                      // first read converts
+    lastReading(0),                                                        // nothing sampled yet
+    key(OPTA_LADDER_NONE)                                                  // no key pressed
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- readChannel() ----------
+bool OptaAnalogLadder::readChannel(uint8_t k) {
+  if (k >= keyCount) return false;  // no such key
+  uint16_t bit = uint16_t(1u << k);
+  if (readMask & bit) {  // this key was already read from the current sample: new scan
+    convert();
+    readMask = 0;
+  }
+  readMask |= bit;  // one read per key per sample
+  return key == k;
+}
+
+// ---------- sample() ----------
+uint16_t OptaAnalogLadder::sample() {
+  return uint16_t(analogRead(pin));  // override for other ADCs
+}
+
+// ---------- convert() ----------
+void OptaAnalogLadder::convert() {
+  uint16_t r = sample();  // the one conversion for this scan
+  lastReading = r;
+
+  // Keep the current key while the reading stays inside its widened window
+  if (key != OPTA_LADDER_NONE) {
+    uint16_t level = table[key];
+    uint16_t distance = (r > level) ? r - level : level - r;
+    if (distance <= uint32_t(window) + stickiness) return;
+  }
+
+  // Otherwise take the closest level within tolerance, if any
+  key = OPTA_LADDER_NONE;
+  uint16_t best = window;
+  for (uint8_t i = 0; i < keyCount; i++) {
+    uint16_t distance = (r > table[i]) ? r - table[i] : table[i] - r;
+    if (distance <= best) {
+      best = distance;
+      key = i;
+    }
+  }
+}
+
+// Query functions
+uint8_t OptaAnalogLadder::getKey() const {
+  return key;
+}
+uint16_t OptaAnalogLadder::getLastReading() const {
+  return lastReading;
+}
+
+// OptaAnalogLadder.cpp
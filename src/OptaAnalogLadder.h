@@ -0,0 +1,78 @@
+/*
+  NAME:
+    OptaAnalogLadder — Several buttons on one analog input (resistor ladder)
+
+  Purpose
+  Digital channels run out fast on a small panel. A resistor ladder puts
+  several buttons on one analog input: each button pulls the input to its
+  own voltage, and this provider turns one conversion into a key number:
+    • One ADC sample per scan, however many buttons share the ladder
+    • A threshold table: the reading each key produces, plus a tolerance
+    • Hysteresis, so a reading sitting on a tolerance edge doesn't flicker
+  Each key then feeds an ordinary OptaButton, so debounce, long press,
+  repeat, taps and chords all work unchanged.
+
+  How to Use
+    const uint16_t levels[] = { 0, 145, 330, 505, 740 };  // analogRead() with each key pressed
+    OptaAnalogLadder ladder(A0, levels, 5);               // tolerance 30, hysteresis 10
+    OptaButton btnRight(ladder, 0, "Right");              // key 0
+    OptaButton btnUp(ladder, 1, "Up");                    // key 1 ...
+
+  Measure the levels on the real panel (print getLastReading() with each
+  key held) and leave at least 2 x (tolerance + hysteresis) between them.
+  With no key pressed the reading matches no level and every key reads
+  released. Only one key is reported at a time, as a ladder can't tell two
+  keys apart.
+
+  Scans
+  Like OptaExpansionCache, the ladder starts a new conversion when a key
+  asks a second time: every key is then read once per conversion without
+  any call from the sketch. The default sample() is analogRead(pin); for an
+  Opta analog expansion, or to average several samples, derive a class and
+  override sample().
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaInputProvider.h"  // the interface we implement
+
+// Keys one ladder can decode (one bit each in the read mask)
+static constexpr uint8_t OPTA_LADDER_MAX_KEYS = 16;
+
+// getKey() when the reading matches no key
+static constexpr uint8_t OPTA_LADDER_NONE = 0xFF;
+
+class OptaAnalogLadder : public OptaInputProvider {
+public:
+  // ---------- Constructor ----------
+  OptaAnalogLadder(
+    uint8_t analogPin,        // input the ladder is wired to (ignored if sample() is overridden)
+    const uint16_t* levels,   // reading produced by each key (must outlive the ladder)
+    uint8_t count,            // how many keys, up to OPTA_LADDER_MAX_KEYS
+    uint16_t tolerance = 30,  // a reading this close to a level selects that key
+    uint16_t hysteresis = 10  // and it stays selected until it drifts this much further
+  );                          // end constructor
+
+  bool readChannel(uint8_t key) override;  // true while key is the one decoded
+
+  // ---------- Query Functions ----------
+  uint8_t getKey() const;              // decoded key, or OPTA_LADDER_NONE
+  uint16_t getLastReading() const;     // raw value of the last conversion (for calibration)
+
+protected:
+  virtual uint16_t sample();  // one conversion; default analogRead(pin)
+
+private:
+  const uint8_t pin;          // analog input
+  const uint16_t* table;      // caller-owned levels
+  const uint8_t keyCount;     // clamped to OPTA_LADDER_MAX_KEYS
+  const uint16_t window;      // tolerance
+  const uint16_t stickiness;  // hysteresis
+  uint16_t readMask;          // keys read since the last conversion
+  uint16_t lastReading;       // last sample()
+  uint8_t key;                // decoded from it
+
+  void convert();  // sample and decode
+};
+
+// OptaAnalogLadder.h
@@ -0,0 +1,83 @@
+/*
+  NAME:
+    OptaBankDebouncer — Debounce a whole bank of inputs in parallel
+
+  Purpose
+  Debouncing each button on its own means one set of timers and branches per
+  button. When many inputs arrive together—an AVR port register (PIND), an
+  Opta expansion's 16-channel word, or an OptaButtonGroup snapshot—they can
+  all be debounced at once with a few bitwise operations:
+    • Every bit has its own 2-bit counter, stored "vertically": bit n of
+      count0 and bit n of count1 together form input n's counter
+    • A bit only changes state after 4 samples in a row disagree with it
+    • The cost is the same for 1 input or 32
+
+  How to Use
+    OptaBankDebouncer<uint8_t> portD;         // 8 inputs
+    uint8_t keys = portD.update(~PIND);       // one sample per scan (pressed = 1)
+    if (portD.getPressed() & (1 << 2)) ...    // bit 2 just became pressed
+
+  Word can be uint8_t, uint16_t or uint32_t; pick the smallest that fits.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>  // fixed-width integer types
+
+// Samples in a row a bit must disagree before it flips
+static constexpr uint8_t OPTA_BANK_DEBOUNCE_SAMPLES = 4;
+
+template <typename Word>
+class OptaBankDebouncer {
+public:
+  // ---------- Constructor ----------
+  explicit OptaBankDebouncer(Word initialState = 0)
+    : state(initialState),  // debounced state starts here
+      count0(Word(~0)),     // counters start "full" so they count down from 3
+      count1(Word(~0)),     //
+      changed(0)            // nothing changed yet
+  {
+    // Constructor body empty: all initialization done above
+  }
+
+  // ---------- update() ----------
+  // Feed one raw sample (1 = active), get the debounced state back
+  Word update(Word sample) {
+    Word diff = state ^ sample;               // bits whose sample disagrees with the state
+    count0 = Word(~(count0 & diff));          // low counter bit: toggles while disagreeing, resets otherwise
+    count1 = Word(count0 ^ (count1 & diff));  // high counter bit: carries from the low bit
+    changed = Word(diff & count0 & count1);   // counter rolled over: 4 disagreeing samples in a row
+    state ^= changed;                         // flip exactly those bits
+    return state;
+  }
+
+  // Force a known state (e.g. after begin()) and restart every counter
+  void reset(Word newState) {
+    state = newState;   // trust this as the debounced state
+    count0 = Word(~0);  // restart every counter
+    count1 = Word(~0);  //
+    changed = 0;        // no change reported
+  }
+
+  // ---------- Query Functions ----------
+  Word getState() const {  // debounced state of every bit
+    return state;
+  }
+  Word getChanged() const {  // bits that flipped in the last update()
+    return changed;
+  }
+  Word getPressed() const {  // bits that just became 1
+    return Word(changed & state);
+  }
+  Word getReleased() const {  // bits that just became 0
+    return Word(changed & ~state);
+  }
+
+private:
+  Word state;    // debounced output
+  Word count0;   // vertical counter, low bit
+  Word count1;   // vertical counter, high bit
+  Word changed;  // bits flipped by the last update()
+};
+
+// OptaBankDebouncer.h
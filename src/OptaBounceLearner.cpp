@@ -0,0 +1,91 @@
+/*
+ * OptaBounceLearner.cpp
+ * Per-switch bounce measurement and the debounce window derived from it
+ */
+
+#include "OptaBounceLearner.h"  // include our header
+#include "OptaButtonStats.h"    // optional counters (OPTA_STATS)
+
+// Constructor implementation
+OptaBounceLearner::OptaBounceLearner(uint16_t floorMs, uint16_t ceilingMs, uint8_t marginMs)
+  : floor(floorMs),                                     // save the bounds
+    ceiling(ceilingMs > floorMs ? ceilingMs : floorMs),  // (a ceiling below the floor is the floor)
+    margin(marginMs),                                    // save the margin
+    effective(ceiling),                                  // nothing measured yet: the safe end
+    bursts(0),                                           //
+    start(0),                                            //
+    lastEdge(0),                                         //
+    peak(0),                                             //
+    minWidth(0),                                         //
+    maxWidth(0),                                         //
+    open(false)                                          // no burst in progress
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- reset() ----------
+void OptaBounceLearner::reset() {
+  effective = ceiling;  // nothing measured yet: the safe end
+  bursts = 0;
+  peak = 0;
+  minWidth = 0;
+  maxWidth = 0;
+  open = false;
+}
+
+// ---------- observe() ----------
+void OptaBounceLearner::observe(bool edge, uint32_t now) {
+  if (open && now - lastEdge > uint32_t(OPTA_BOUNCE_GAP_MS) * OPTA_BUTTON_TICKS_PER_MS) {
+    closeBurst();  // quiet long enough: the burst is over
+  }
+  if (!edge) return;  // nothing else to do between edges
+  if (!open) {        // first edge after a quiet spell starts a burst
+    open = true;
+    start = now;
+  }
+  lastEdge = now;
+}
+
+// ---------- closeBurst() ----------
+void OptaBounceLearner::closeBurst() {
+  open = false;
+  uint32_t span = lastEdge - start;                            // 0 for a single clean edge
+  uint32_t limit = uint32_t(ceiling) * OPTA_BUTTON_TICKS_PER_MS;  // beyond the ceiling is not bounce we can use
+  OptaButtonStamp width = OptaButtonStamp(span > limit ? limit : span);
+
+  if (bursts == 0) {
+    minWidth = width;
+    maxWidth = width;
+    peak = width;  // first measurement replaces the safe default
+  } else {
+    if (width < minWidth) minWidth = width;
+    if (width > maxWidth) maxWidth = width;
+    if (width >= peak) peak = width;      // worse bounce: follow it at once
+    else peak -= (peak - width + 7) / 8;  // better: come down an eighth of the way per burst
+  }
+  if (bursts != 0xFFFF) bursts++;
+  OPTA_STATS(OptaButtonStats::countBounce(uint32_t(width) * OPTA_BUTTON_US_PER_TICK));
+
+  // Round the measurement up to whole ms, add the margin, then clamp
+  uint32_t ms = (uint32_t(peak) + OPTA_BUTTON_TICKS_PER_MS - 1) / OPTA_BUTTON_TICKS_PER_MS + margin;
+  effective = uint16_t(ms < floor ? floor : (ms > ceiling ? ceiling : ms));
+}
+
+// Query functions
+uint16_t OptaBounceLearner::getDebounceMs() const {
+  return effective;
+}
+uint16_t OptaBounceLearner::getMinBounceMs() const {
+  return uint16_t(minWidth / OPTA_BUTTON_TICKS_PER_MS);
+}
+uint16_t OptaBounceLearner::getMaxBounceMs() const {
+  return uint16_t((maxWidth + OPTA_BUTTON_TICKS_PER_MS - 1) / OPTA_BUTTON_TICKS_PER_MS);
+}
+uint16_t OptaBounceLearner::getBursts() const {
+  return bursts;
+}
+bool OptaBounceLearner::isMeasuring() const {
+  return open;
+}
+
+// OptaBounceLearner.cpp
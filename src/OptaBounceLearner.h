@@ -0,0 +1,79 @@
+/*
+  NAME:
+    OptaBounceLearner — Adaptive debounce that learns how much a switch bounces
+
+  Purpose
+  A crisp tactile button settles in well under a millisecond; a worn
+  mushroom e-stop can chatter for 30 ms or more. One fixed debounceMs for
+  both either adds latency to the good one or lets bounce through on the
+  bad one. A learner watches one button's raw input and sets its debounce
+  window just above the bounce it actually measured:
+    • Raw edges closer together than OPTA_BOUNCE_GAP_MS belong to one burst
+    • A burst's width (first to last edge) is one bounce measurement
+    • Window = widest recent burst + margin, kept within [floorMs, ceilingMs]
+    • A wider burst raises the window at once; narrower ones lower it slowly
+  Until the first burst has been measured the window is ceilingMs, the safe
+  end of the range.
+
+  How to Use
+    OptaBounceLearner estopBounce(2, 60);   // learn between 2 and 60 ms
+    estop.setAdaptiveDebounce(estopBounce);  // after that, debounceMs is ignored
+    ...
+    Serial.println(estopBounce.getMaxBounceMs());  // what the switch did
+
+  Works with every OptaDebounceMode. With IMMEDIATE the window is the
+  lockout after the first edge; with STABLE and INTEGRATOR it is also the
+  press latency, so that is where learning pays off most. The learned
+  widths are also counted by OptaButtonStats (bounce bursts, widest burst).
+
+  While a burst is open the button does not report isIdle(), so an
+  OptaButtonGroup keeps sampling it and the burst closes on time, one
+  OPTA_BOUNCE_GAP_MS after its last edge, instead of at the next press.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>          // fixed-width integer types
+#include "OptaButtonClock.h"  // OptaButtonStamp ticks
+
+// Raw edges closer together than this are one bounce burst
+#ifndef OPTA_BOUNCE_GAP_MS
+#define OPTA_BOUNCE_GAP_MS 10
+#endif
+
+class OptaBounceLearner {
+public:
+  // ---------- Constructor ----------
+  OptaBounceLearner(
+    uint16_t floorMs = 1,     // never debounce for less than this
+    uint16_t ceilingMs = 50,  // nor for more (also the window before anything is learned)
+    uint8_t marginMs = 2      // added on top of the widest recent burst
+  );                          // end constructor
+
+  void observe(bool edge, uint32_t now);  // every sample; edge = the raw input changed
+  void reset();                           // forget everything, back to ceilingMs
+
+  // ---------- Query Functions ----------
+  uint16_t getDebounceMs() const;   // window in use right now
+  uint16_t getMinBounceMs() const;  // narrowest burst measured (0 = a clean edge)
+  uint16_t getMaxBounceMs() const;  // widest burst measured
+  uint16_t getBursts() const;       // bursts measured (saturates)
+  bool isMeasuring() const;         // a burst is open: keep sampling until it has been quiet OPTA_BOUNCE_GAP_MS
+
+private:
+  const uint16_t floor;      // lower bound for the window
+  const uint16_t ceiling;    // upper bound for the window
+  const uint8_t margin;      // safety added to the measurement
+  uint16_t effective;        // current window in ms (read every sample)
+  uint16_t bursts;           // measurements so far (saturates)
+  uint32_t start;            // first edge of the open burst (full ticks: a quiet spell longer
+  uint32_t lastEdge;         // than the 16-bit stamp range must not merge two bursts)
+  OptaButtonStamp peak;      // decaying widest burst, in ticks
+  OptaButtonStamp minWidth;  // narrowest burst, in ticks
+  OptaButtonStamp maxWidth;  // widest burst, in ticks
+  bool open;                 // a burst is in progress
+
+  void closeBurst();  // measure the burst that just went quiet
+};
+
+// OptaBounceLearner.h
@@ -0,0 +1,58 @@
+/*
+ * OptaBulkInput.cpp
+ * Snapshot bookkeeping shared by the bulk-read backends
+ */
+
+#include "OptaBulkInput.h"    // include our header
+#include "OptaButtonStats.h"  // optional bus-read counters
+
+// Constructor implementation
+OptaBulkInput::OptaBulkInput(uint8_t channelCount, bool activeLow)
+  : count(channelCount > OPTA_BULK_MAX_CHANNELS ? OPTA_BULK_MAX_CHANNELS : channelCount),  // never more than we hold
+    invertBits(activeLow),  // save polarity
+    started(false),         // bus set up on the first begin()
+    snapshot(),             // nothing active
+    readMask()              // set below
+{
+  memset(readMask, 0xFF, sizeof(readMask));  // the first read starts a burst
+}
+
+// ---------- begin() ----------
+void OptaBulkInput::begin() {
+  if (started) return;  // every button calls begin(): only the first one counts
+  started = true;
+  beginBus();
+}
+
+// ---------- readChannel() ----------
+bool OptaBulkInput::readChannel(uint8_t channel) {
+  if (channel >= count) return false;  // no such channel
+  uint8_t byte = channel >> 3;         // where its bit lives
+  uint8_t bit = uint8_t(1u << (channel & 7));
+  if (readMask[byte] & bit) refresh();  // already read from this snapshot: new scan
+  readMask[byte] |= bit;                // one read per channel per burst
+  return snapshot[byte] & bit;
+}
+
+// ---------- refresh() ----------
+void OptaBulkInput::refresh() {
+  if (!started) begin();  // read before begin(): set the bus up now
+  uint8_t bytes = (count + 7) >> 3;
+  OPTA_STATS(uint32_t statsStart = micros());  // time the burst, if enabled
+  readBurst(snapshot);                         // the one bus transaction for this scan
+  OPTA_STATS(OptaButtonStats::expansionRefresh(micros() - statsStart));
+  for (uint8_t i = 0; i < bytes; i++) {
+    if (invertBits) snapshot[i] = uint8_t(~snapshot[i]);  // store "active" as 1
+    readMask[i] = 0;                                      // nobody has read this burst yet
+  }
+}
+
+// Query functions
+bool OptaBulkInput::getChannel(uint8_t channel) const {
+  return channel < count && (snapshot[channel >> 3] & (1u << (channel & 7)));
+}
+uint8_t OptaBulkInput::getChannelCount() const {
+  return count;
+}
+
+// OptaBulkInput.cpp
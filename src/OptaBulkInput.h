@@ -0,0 +1,65 @@
+/*
+  NAME:
+    OptaBulkInput — One bus burst per scan for large keypads
+
+  Purpose
+  Shift-register chains and I2C port expanders deliver 8 or 16 inputs per
+  transfer. Reading them one button at a time would repeat the same bus
+  transaction 32-64 times per scan. This base class keeps a snapshot of
+  every channel instead:
+    • readBurst() fills the snapshot in one go (one SPI or I2C burst)
+    • readChannel() just picks a bit out of it
+    • A new burst starts when a channel is asked for a second time, so every
+      button (stand-alone or in an OptaButtonGroup) reads one snapshot per
+      scan without any call from the sketch
+  Up to OPTA_BULK_MAX_CHANNELS channels; channel n is bit (n % 8) of byte
+  (n / 8) of the snapshot.
+
+  Ready-made backends
+    • Opta74HC165   – chain of 74HC165 parallel-in shift registers on SPI
+    • OptaMCP23017  – one or more MCP23017 expanders on I2C
+
+  Your own backend
+    class MyChain : public OptaBulkInput {
+    public:
+      MyChain() : OptaBulkInput(24, true) {}           // 24 channels, active-LOW
+    protected:
+      void readBurst(uint8_t* bytes) override { ... }  // fill 3 bytes
+    };
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaInputProvider.h"  // the interface we implement
+
+// Largest snapshot a bulk provider keeps (64 channels = 8 bytes)
+static constexpr uint8_t OPTA_BULK_MAX_CHANNELS = 64;
+
+class OptaBulkInput : public OptaInputProvider {
+public:
+  void begin() override;                       // sets up the bus once, however many buttons share us
+  bool readChannel(uint8_t channel) override;  // one bit of the snapshot
+
+  void refresh();                          // burst-read every channel right now
+  bool getChannel(uint8_t channel) const;  // snapshot bit without starting a new scan
+  uint8_t getChannelCount() const;         // channels this provider has
+
+protected:
+  // ---------- Constructor ----------
+  OptaBulkInput(
+    uint8_t channelCount,  // how many channels the hardware has, up to OPTA_BULK_MAX_CHANNELS
+    bool activeLow         // true = a LOW bit means active (buttons to GND with pull-ups)
+  );                       // end constructor
+
+  virtual void beginBus() {}                   // one-time hardware setup (pin modes, SPI/Wire.begin())
+  virtual void readBurst(uint8_t* bytes) = 0;  // fill (channels + 7) / 8 bytes in one transaction
+
+private:
+  const uint8_t count;                           // clamped to OPTA_BULK_MAX_CHANNELS
+  const bool invertBits;                         // active-LOW hardware
+  bool started;                                  // beginBus() already ran
+  uint8_t snapshot[OPTA_BULK_MAX_CHANNELS / 8];  // the last burst, active = 1
+  uint8_t readMask[OPTA_BULK_MAX_CHANNELS / 8];  // channels read since that burst
+};
+
+// OptaBulkInput.h
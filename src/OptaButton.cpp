@@ -3,10 +3,23 @@
  * Button handler implementation with comments on each line
  */
 
-#include "OptaButton.h"  // include our header
+#include "OptaButton.h"          // include our header
+#include "OptaExpansionCache.h"  // shared per-expansion input cache
+#include "OptaEdgeCapture.h"     // optional ISR edge capture
 
-// Shared gate so expansion inputs are refreshed at most once per loop pass
-static uint32_t g_optaExpRefreshToken = 0;  // increments once per button update call chain
+#if defined(__AVR__)
+// SRAM per button on AVR: 44 bytes with every optional feature off, plus what each
+// one adds (the "Saving RAM" table in the README). Update both together
+static constexpr size_t OPTA_BUTTON_AVR_BYTES = 44
+  + 2 * OPTA_BUTTON_LABELS
+  + 5 * OPTA_BUTTON_CALLBACKS * OPTA_BUTTON_CALLBACK_SLOTS
+  + 3 * OPTA_BUTTON_TRACE
+  + 6 * OPTA_BUTTON_TAPS
+  + 3 * OPTA_BUTTON_GESTURES
+  + 2 * OPTA_BUTTON_ADAPTIVE
+  + 2 * OPTA_BUTTON_MICROS * (6 + OPTA_BUTTON_TAPS);  // 32-bit stamps: 2 more bytes per timer
+static_assert(sizeof(OptaButton) <= OPTA_BUTTON_AVR_BYTES, "OptaButton grew on AVR: check the SRAM budget");
+#endif
 
 // Constructor implementation
 OptaButton::OptaButton(
@@ -18,41 +31,118 @@ OptaButton::OptaButton(
   uint16_t longPressMs,
   uint16_t repeatStartMs,
   uint16_t repeatMinMs,
-  uint8_t accelRate)
+  uint8_t accelRate,
+  OptaDebounceMode debounceMode)
+
+  // Same as the expansion-index constructor, with EXP_DIG on the first expansion found
+  : OptaButton(mode, OPTA_EXP_ANY, inputPin, label, debounceMs, inverted,
+               longPressMs, repeatStartMs, repeatMinMs, accelRate, debounceMode)
+{
+  // Constructor body empty: the other constructor does the work
+}
+
+// Constructor implementation (user input source)
+OptaButton::OptaButton(
+  OptaInputProvider& inputProvider,  // where samples come from
+  uint8_t channel,                   // channel on that provider
+  const char* label,                 // button name
+  uint16_t debounceMs,
+  bool inverted,
+  uint16_t longPressMs,
+  uint16_t repeatStartMs,
+  uint16_t repeatMinMs,
+  uint8_t accelRate,
+  OptaDebounceMode debounceMode)
+
+  // Not a local pin: reuse the EXP_DIG constructor, then point at the provider
+  : OptaButton(DefLab::ButtonInputMode::EXP_DIG, OPTA_EXP_ANY, channel, label, debounceMs, inverted,
+               longPressMs, repeatStartMs, repeatMinMs, accelRate, debounceMode)
+{
+  provider = &inputProvider;  // readInput() asks the provider instead of the bus
+}
+
+// Constructor implementation (EXP_DIG on a specific expansion)
+OptaButton::OptaButton(
+  DefLab::ButtonInputMode mode,  // hardware mode
+  uint8_t expansionIndex,        // which expansion (EXP_DIG only)
+  uint8_t channel,               // pin or channel
+  const char* label,             // button name
+  uint16_t debounceMs,
+  bool inverted,
+  uint16_t longPressMs,
+  uint16_t repeatStartMs,
+  uint16_t repeatMinMs,
+  uint8_t accelRate,
+  OptaDebounceMode debounceMode)
 
   // Now that you've named the public parameters, assign them
-  : inputMode(mode),                       // save mode
-    inputID(inputPin),                     // save pin
-    name(label),                           // save label
-    debounceTime(debounceMs),              // save debounce time
-    invertedLogic(inverted),               // save inversion flag
-    longPressThreshold(longPressMs),       // save long-press threshold
-    repeatIntervalStart(repeatStartMs),    // save initial repeat interval
-    repeatIntervalMin(repeatMinMs),        // save minimum repeat interval
-    currentRepeatInterval(repeatStartMs),  // start repeats at initial interval
-    acceleration(accelRate),               // save acceleration speed
+  : OptaButtonCore<OptaButton>(repeatStartMs),  // start repeats at initial interval
+    inputMode(mode),                             // save mode
+    inputID(channel),                            // save pin
+    expansionID(expansionIndex),                 // save expansion index
+#if OPTA_BUTTON_LABELS
+    name(label),                                 // save label
+#endif
+    debounceTime(debounceMs),                    // save debounce time
+    invertedLogic(inverted),                     // save inversion flag
+    longPressThreshold(longPressMs),             // save long-press threshold
+    repeatIntervalStart(repeatStartMs),          // save initial repeat interval
+    repeatIntervalMin(repeatMinMs),              // save minimum repeat interval
+    acceleration(accelRate),                     // save acceleration speed
+    debounceStrategy(debounceMode),              // save debounce strategy
+    repeatCurve(nullptr),                        // linear acceleration until setRepeatCurve()
+#if OPTA_BUTTON_ADAPTIVE
+    bounceLearner(nullptr),                      // fixed debounce until setAdaptiveDebounce()
+#endif
+    provider(nullptr),                           // built-in input modes
 
     // And initialize these runtime variables
     lastUpdateTime(0),           // no updates yet
-    edgeTime(0),                 // no edge yet
-    lastRepeatTime(0),           // no repeats yet
-    lastAccelUpdate(0),          // no accel steps yet
-    rawState(false),             // assume not pressed
-    debouncing(false),           // not in debounce initially
-    currentPressed(false),       // debounced state false
-    longPressActive(false),      // long-press not active
-    shortPressDetected(false),   // clear all event flags
-    releaseDetected(false),      //
-    longPressDetected(false),    //
-    longReleaseDetected(false),  //
-    repeatTriggered(false),      //
-    longPressReported(false)     // initialize the guard
+    expScanSeen(0),              // no expansion scans seen yet
+    expSlot(OPTA_EXP_NONE),      // resolved in begin()
+    topologySeen(0),             //
+    edgeSlot(OPTA_EDGE_NONE),    // polling until useInterrupts()
+    holdShortPress(false),       // report presses right away
+    shortPending(false),         //
+    chordConsumed(false),        // not part of a chord
+#if OPTA_BUTTON_TAPS
+    tapWindow(0),                // taps off until setMultiTap()
+    tapTime(0),                  //
+    taps(0),                     //
+    tapLimit(2),                 //
+    tapDeferShort(false),        //
+    tapDown(false),              //
+    doubleTapDetected(false),    //
+    tripleTapDetected(false),    //
+    tapFirstId(0),               //
+#endif
+    pressId(0),                  // no press yet
+#if OPTA_BUTTON_GESTURES
+    gesturePressId(0),           //
+    gesture(OptaGesture::NONE),  // nothing classified
+    gestureEvents(false),        // off until setGestureEvents()
+    pressBeginDetected(false),   //
+    pressClassified(false),      //
+#endif
+    eventQueue(nullptr),         // flags only until attachQueue()
+    eventId(0)                   //
+#if OPTA_BUTTON_TRACE
+    , traceRecorder(nullptr)     // not logging until attachTrace()
+    , traceId(0)                 //
+#endif
+#if OPTA_BUTTON_CALLBACKS
+    , callbacks()                // no handlers registered
+#endif
 {
-  // Constructor body empty: all initialization done above
+  (void)label;  // unused when labels are compiled out
 }
 
 // ---------- begin() ----------
 void OptaButton::begin() {
+  if (provider) {       // user input source
+    provider->begin();  // let it set up its own hardware
+    return;
+  }
   switch (inputMode) {
     case DefLab::ButtonInputMode::GPIO:
       pinMode(inputID, INPUT_PULLUP);  // use internal pullup resistor
@@ -61,154 +151,586 @@ void OptaButton::begin() {
       pinMode(inputID, INPUT);  // simple digital input
       break;
     case DefLab::ButtonInputMode::EXP_DIG:
-      // no setup needed for digital expansion
+      resolveExpansion();  // find our expansion once instead of on every poll
       break;
   }
 }
 
+// ---------- resolveExpansion() ----------
+void OptaButton::resolveExpansion() {
+  expSlot = OptaExpansionCache::resolve(expansionID);         // index we actually read from
+  topologySeen = OptaExpansionCache::getTopologyVersion();  // redo this only if the bus changes
+}
+
 // ---------- update() ----------
 void OptaButton::update() {
-  // Clear all the event flags first
-  shortPressDetected = false;
-  releaseDetected = false;
-  longPressDetected = false;
-  longReleaseDetected = false;
-  repeatTriggered = false;
-
-  // Then check the loop timer
-  uint32_t now = millis();                              // read current time
-  if (now - lastUpdateTime < LOOP_INTERVAL_MS) return;  // too soon, skip
-  lastUpdateTime = now;                                 // mark this update time
-
-  // Gate token: advance at most once per millisecond tick
-  static uint32_t lastTokenMs = 0;  // last millis() tick used to advance the token
-  if (now != lastTokenMs) {         // only advance once per tick
-    g_optaExpRefreshToken++;        // token changes, enabling one refresh
-    lastTokenMs = now;              // remember this tick
+  // Check the loop timer, then scan at the time we just read
+  uint32_t now = optaButtonNow();                       // read current time (ms or us ticks)
+  if (OptaButtonStamp(now - lastUpdateTime) < LOOP_INTERVAL_TICKS) {
+    clearEvents();  // too soon: flags still only live for one update()
+    return;
   }
+  scan(now, true);  // edge ages measured against the hardware clock
+}
+
+// ---------- update(nowTicks) ----------
+// The caller owns the timebase and the rate: every call is one scan at nowTicks
+void OptaButton::update(uint32_t now) {
+  scan(now, false);  // no clock read: edges are placed relative to nowTicks
+}
+
+// ---------- scan() ----------
+void OptaButton::scan(uint32_t now, bool edgeClock) {
+  // Clear all the event flags first
+  clearEvents();
+  lastUpdateTime = now;  // mark this update time (keeps a later update() gate consistent)
+  OPTA_STATS(uint32_t statsStart = OptaButtonStats::scanBegin());  // scan timing, if enabled
+
+  // Replay any edges the ISR caught since last time, with their real timestamps
+  drainEdges(now, edgeClock);
 
   // Then poll the pins
   bool pressed = readInput();  // return true if the hardware reads “pressed”
 
-  // If state just changed AND we’re not already waiting out a debounce, treat it as a real edge
-  if (pressed != rawState && !debouncing) {
-    rawState = pressed;  // remember this new raw input so we can detect future changes
-    debouncing = true;   // starting next loop, pass this logic gate until debounceTime
-    edgeTime = now;      // stamp the exact millisecond of this transition for timing
-
-    if (pressed) {
-      shortPressDetected = true;                    // fire a one‑time “button down” event right now
-      currentPressed = true;                        // immediately update our logical state to “down”
-      longPressActive = false;                      // clear any leftover long‑press status
-      currentRepeatInterval = repeatIntervalStart;  // reset the repeat delay back to its initial value
-      lastRepeatTime = now;                         // schedule the first repeat after that start delay
-      lastAccelUpdate = now;                        // start counting from now toward the next speed‑up
-    } else {
-      releaseDetected = true;                 // fire a one‑time “button up” event right now
-      longReleaseDetected = longPressActive;  // if we were in a long‑press, report its end
-      currentPressed = false;                 // immediately update our logical state to “up”
-      longPressActive = false;                // turn off the long‑press flag so repeats stop
-      longPressReported = false;              // allow the next press to be reported as a long‑press again
+  // Hand the sample to the state machine
+  processSample(pressed, now);  // debounce, edges, long press, repeats
+  checkTaps(now);               // a tap sequence may have timed out
+  OPTA_STATS(OptaButtonStats::scanEnd(statsStart));
+
+  // Pipelined expansions: refresh one stale expansion for the next pass
+  if (inputMode == DefLab::ButtonInputMode::EXP_DIG && !provider) OptaExpansionCache::service();
+}
+
+// ---------- dispatchEvent() ----------
+// OptaButtonCore has already set the is*() flag; chord handling may take it back
+void OptaButton::dispatchEvent(OptaButtonEventType type, uint32_t now) {
+  // The raw press edge: tell the UI now, whatever the chord and tap logic decide below
+  if (type == OptaButtonEventType::SHORT_PRESS) beginPress(now);
+
+  // A chord used this press: swallow everything but the release
+  if (chordConsumed) {
+    switch (type) {
+      case OptaButtonEventType::RELEASE:  // the physical release still counts
+        if (!longPressActive) chordConsumed = false;  // (a held chord ends with LONG_RELEASE next)
+        break;
+      case OptaButtonEventType::LONG_PRESS: longPressDetected = false; return;
+      case OptaButtonEventType::LONG_RELEASE: longReleaseDetected = false; chordConsumed = false; return;
+      case OptaButtonEventType::REPEAT: repeatTriggered = false; return;
+      default: return;
     }
   }
 
-  // After the debounce window has passed, allow new edges to be detected
-  if (debouncing && (now - edgeTime >= debounceTime)) {
-    debouncing = false;  // exit debounce, so (pressed != rawState) can fire again
+  // Chord participant: hold the press back until the group knows whether it is part of a chord
+  if (type == OptaButtonEventType::SHORT_PRESS && holdShortPress) {
+    shortPressDetected = false;  // not yet
+    shortPending = true;         // the group flushes or drops it
+    return;
   }
 
-  // Once we’re out of debounce AND the button is held down, handle long‑press timing and repeats
-  if (!debouncing && currentPressed) {
-    // Only fire the long‑press event once, when the hold time crosses the threshold
-    if (!longPressReported && (now - edgeTime >= longPressThreshold)) {
-      longPressDetected = true;  // report “you’ve held it long enough” this one time
-      longPressActive = true;    // enter the long‑press state so repeats can happen
-      longPressReported = true;  // block any further long‑press events until release
-      lastRepeatTime = now;      // reset repeat timer so the first repeat waits the full interval
-      lastAccelUpdate = now;     // reset accel timer so we don’t speed up immediately
+  // Released (or held long) before the group decided: it was a plain press after all
+  if (shortPending && (type == OptaButtonEventType::RELEASE || type == OptaButtonEventType::LONG_PRESS)) {
+    flushShortPress(now);  // keep SHORT_PRESS ahead of what follows it
+  }
+  deliverEvent(type, now);
+}
+
+// ---------- deliverEvent() ----------
+void OptaButton::deliverEvent(OptaButtonEventType type, uint32_t now) {
+#if OPTA_BUTTON_TAPS
+  if (tapWindow && !trackTaps(type, now)) return;  // held back by the tap counter
+#endif
+  sendEvent(type, now, pressId);
+
+#if OPTA_BUTTON_GESTURES
+  // Without a tap sequence, the press is classified by how it ended (taps go through resolveTaps())
+  if (!gestureEvents || pressClassified) return;
+  if (type == OptaButtonEventType::LONG_PRESS) classify(OptaGesture::HOLD, pressId, now);
+  else if (type == OptaButtonEventType::RELEASE) classify(OptaGesture::TAP, pressId, now);
+#endif
+}
+
+// ---------- flushShortPress() ----------
+void OptaButton::flushShortPress(uint32_t now) {
+  if (!shortPending) return;  // nothing captured
+  shortPending = false;
+  shortPressDetected = true;  // isShortPressed() for this scan, a little late
+  deliverEvent(OptaButtonEventType::SHORT_PRESS, now);
+}
+
+// ---------- sendEvent() ----------
+void OptaButton::sendEvent(OptaButtonEventType type, uint32_t now, uint8_t id) {
+  // Keep a copy in the queue, if one is attached
+  if (eventQueue) {
+    OptaButtonEvent event;     // build the queue entry
+    event.time = now;          // when it happened
+    event.buttonId = eventId;  // who it happened to
+    event.type = type;         // what happened
+    event.pressId = id;        // which press
+#if OPTA_BUTTON_GESTURES
+    event.gesture = (type == OptaButtonEventType::GESTURE) ? gesture : OptaGesture::NONE;
+#else
+    event.gesture = OptaGesture::NONE;
+#endif
+    event.step = (type == OptaButtonEventType::REPEAT) ? uint8_t(repeatStep()) : 1;  // frozen now: the live step changes under a reader
+    eventQueue->push(event);   // a full queue counts the drop and moves on
+  }
+
+#if OPTA_BUTTON_CALLBACKS
+  // And call the registered handler, if any
+  for (uint8_t i = 0; i < OPTA_BUTTON_CALLBACK_SLOTS; i++) {
+    const Callback& cb = callbacks[i];
+    if (cb.fn && cb.type == type) {  // only real transitions cost a call
+      cb.fn(*this, cb.context);
+      break;                         // one handler per type
     }
+  }
+#endif
+}
+
+#if OPTA_BUTTON_TAPS
+// ---------- setMultiTap() ----------
+void OptaButton::setMultiTap(uint16_t windowMs, uint8_t maxTaps, bool deferShortPress) {
+  tapWindow = windowMs;                      // 0 turns counting off
+  tapLimit = (maxTaps >= 3) ? 3 : 2;         // double or triple tap at most
+  tapDeferShort = deferShortPress && windowMs;
+  taps = 0;                                  // start a fresh sequence
+  tapDown = false;
+}
+
+// ---------- trackTaps() ----------
+// Called for every event on its way out; counts taps and holds back deferred short presses
+bool OptaButton::trackTaps(OptaButtonEventType type, uint32_t now) {
+  switch (type) {
+    case OptaButtonEventType::SHORT_PRESS:
+      if (taps && OptaButtonStamp(OptaButtonStamp(now) - tapTime) >= optaButtonTicks(tapWindow)) {
+        resolveTaps(now);  // the old sequence ran out in the same scan this press arrived
+      }
+      tapDown = true;              // a tap if released before the long press
+      if (!taps) tapFirstId = pressId;  // this press opens the sequence
+      if (!tapDeferShort) return true;
+      shortPressDetected = false;  // deferred: the sequence decides later
+      return false;
+
+    case OptaButtonEventType::LONG_PRESS:
+      tapDown = false;                  // a hold, not a tap
+      if (taps) resolveTaps(now);       // earlier taps are complete: report them ahead of the hold
+      if (tapDeferShort) {              // the hold's own SHORT_PRESS was held back as well
+        shortPressDetected = true;
+        sendEvent(OptaButtonEventType::SHORT_PRESS, now, pressId);
+      }
+      return true;
+
+    case OptaButtonEventType::RELEASE:
+      if (!tapDown) return true;       // end of a hold or a chord
+      tapDown = false;
+      taps++;                          // one more tap
+      tapTime = OptaButtonStamp(now);
+      if (tapDeferShort) releaseDetected = false;  // deferred: reported with the sequence's result
+      else sendEvent(type, now, pressId);          // release first, then whatever it completed
+      if (taps >= tapLimit) resolveTaps(now);      // can't get any longer: report right away
+      return false;
+
+    default:
+      return true;
+  }
+}
 
-    // If we’re in long‑press mode and the repeat interval has elapsed, fire another repeat
-    if (longPressActive && (now - lastRepeatTime >= currentRepeatInterval)) {
-      repeatTriggered = true;                   // report a repeat event now
-      lastRepeatTime += currentRepeatInterval;  // schedule the next one at the same interval
+// ---------- resolveTaps() ----------
+// Every counted tap has been released, whatever the button is doing now
+void OptaButton::resolveTaps(uint32_t now) {
+  uint8_t n = taps;
+  taps = 0;  // sequence closed
+  if (n == 1) {
+    if (tapDeferShort) {           // otherwise already reported when it happened
+      shortPressDetected = true;   // isShortPressed() for this scan, a window late
+      sendEvent(OptaButtonEventType::SHORT_PRESS, now, tapFirstId);
+      releaseDetected = true;      // and the release that came with it
+      sendEvent(OptaButtonEventType::RELEASE, now, tapFirstId);
     }
+    classify(OptaGesture::TAP, tapFirstId, now);
+  } else if (n == 2) {
+    doubleTapDetected = true;
+    emitFor(OptaButtonEventType::DOUBLE_TAP, tapFirstId, now);  // the sequence is the press that opened it
+    classify(OptaGesture::DOUBLE_TAP, tapFirstId, now);
+  } else if (n == 3) {
+    tripleTapDetected = true;
+    emitFor(OptaButtonEventType::TRIPLE_TAP, tapFirstId, now);
+    classify(OptaGesture::TRIPLE_TAP, tapFirstId, now);
+  }
+}
+#endif
+
+// ---------- checkTaps() ----------
+void OptaButton::checkTaps(uint32_t now) {
+#if OPTA_BUTTON_TAPS
+  if (!taps || currentPressed) return;  // no sequence, or the next tap is in progress
+  if (OptaButtonStamp(OptaButtonStamp(now) - tapTime) < optaButtonTicks(tapWindow)) return;  // still open
+  resolveTaps(now);
+#else
+  (void)now;  // taps compiled out
+#endif
+}
+
+#if OPTA_BUTTON_GESTURES
+// ---------- setGestureEvents() ----------
+void OptaButton::setGestureEvents(bool enable) {
+  gestureEvents = enable;
+  pressClassified = true;  // a press already in progress is not classified
+}
+#endif
+
+// ---------- beginPress() ----------
+void OptaButton::beginPress(uint32_t now) {
+  pressId++;                // new press, new id (wraps)
+#if OPTA_BUTTON_GESTURES
+  pressClassified = false;  // its GESTURE is still to come
+  if (!gestureEvents) return;
+  pressBeginDetected = true;
+  emitFor(OptaButtonEventType::PRESS_BEGIN, pressId, now);  // never held back
+#else
+  (void)now;  // gestures compiled out
+#endif
+}
+
+// ---------- classify() ----------
+void OptaButton::classify(OptaGesture g, uint8_t id, uint32_t now) {
+#if OPTA_BUTTON_GESTURES
+  if (!gestureEvents) return;  // nobody asked for GESTURE events
+  gesture = g;  // getGesture() for this scan
+  gesturePressId = id;
+  if (id == pressId) pressClassified = true;  // (a tap sequence can close while the next press is down)
+  emitFor(OptaButtonEventType::GESTURE, id, now);  // final: no chord or tap filtering
+#else
+  (void)g;  // gestures compiled out
+  (void)id;
+  (void)now;
+#endif
+}
+
+// ---------- emitFor() ----------
+// emit() for an event that belongs to an earlier press: counted and traced, then sent with that id
+void OptaButton::emitFor(OptaButtonEventType type, uint8_t id, uint32_t now) {
+  OPTA_STATS(OptaButtonStats::countEvent(type));
+  traceRecord(OptaTraceKind::EVENT, uint8_t(type), now);
+  sendEvent(type, now, id);
+}
+
+// ---------- consumeByChord() ----------
+void OptaButton::consumeByChord(uint32_t now) {
+  shortPending = false;  // the chord replaces this press
+  chordConsumed = true;  // and whatever it would report until released
+#if OPTA_BUTTON_GESTURES
+  if (!pressClassified) classify(OptaGesture::CHORD, pressId, now);
+#else
+  (void)now;  // gestures compiled out
+#endif
+}
 
-    // Once per second during a long‑press, shorten the repeat interval until it hits the minimum
-    if (longPressActive
-        && (now - lastAccelUpdate >= 1000)
-        && currentRepeatInterval > repeatIntervalMin) {
-      // subtract our acceleration amount, but never go below the configured minimum
-      currentRepeatInterval = max(
-        int(currentRepeatInterval - acceleration),
-        int(repeatIntervalMin));
-      lastAccelUpdate = now;  // reset the 1 s accel timer for the next speed‑up
+// ---------- clearEvents() ----------
+void OptaButton::clearEvents() {
+  OptaButtonCore<OptaButton>::clearEvents();  // the core's one-shot flags
+#if OPTA_BUTTON_TAPS
+  doubleTapDetected = false;                  // and ours
+  tripleTapDetected = false;                  //
+#endif
+#if OPTA_BUTTON_GESTURES
+  pressBeginDetected = false;                 //
+  gesture = OptaGesture::NONE;                //
+#endif
+}
+
+#if OPTA_BUTTON_CALLBACKS
+// ---------- on() / onShortPress() ... ----------
+bool OptaButton::on(OptaButtonEventType type, OptaButtonHandler fn, void* context) {
+  if (uint8_t(type) >= OPTA_BUTTON_EVENT_TYPES) return false;  // unknown type: ignore
+  Callback* slot = nullptr;                                      // where this handler goes
+  for (uint8_t i = 0; i < OPTA_BUTTON_CALLBACK_SLOTS; i++) {
+    if (callbacks[i].fn && callbacks[i].type == type) {          // replace (or remove) this type's handler
+      slot = &callbacks[i];
+      break;
     }
+    if (!callbacks[i].fn && !slot) slot = &callbacks[i];         // first free slot, in case it's new
   }
+  if (!slot) return !fn;     // full: removing a handler that isn't there still succeeds
+  slot->fn = fn;             // nullptr frees the slot
+  slot->context = context;   // handed back on every call
+  slot->type = type;
+  return true;
+}
+bool OptaButton::onShortPress(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::SHORT_PRESS, fn, context);
+}
+bool OptaButton::onRelease(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::RELEASE, fn, context);
+}
+bool OptaButton::onLongPress(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::LONG_PRESS, fn, context);
+}
+bool OptaButton::onLongRelease(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::LONG_RELEASE, fn, context);
+}
+bool OptaButton::onRepeat(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::REPEAT, fn, context);
+}
+#if OPTA_BUTTON_TAPS
+bool OptaButton::onDoubleTap(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::DOUBLE_TAP, fn, context);
+}
+bool OptaButton::onTripleTap(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::TRIPLE_TAP, fn, context);
+}
+#endif
+#if OPTA_BUTTON_GESTURES
+bool OptaButton::onPressBegin(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::PRESS_BEGIN, fn, context);
+}
+bool OptaButton::onGesture(OptaButtonHandler fn, void* context) {
+  return on(OptaButtonEventType::GESTURE, fn, context);
+}
+#endif
+#endif
+
+// ---------- traceRecord() ----------
+void OptaButton::traceRecord(OptaTraceKind kind, uint8_t value, uint32_t now) {
+#if OPTA_BUTTON_TRACE
+  if (traceRecorder) traceRecorder->record(kind, traceId, value, now);  // just packs a few bytes
+#else
+  (void)kind;  // recorder compiled out
+  (void)value;
+  (void)now;
+#endif
+}
+
+#if OPTA_BUTTON_TRACE
+// ---------- attachTrace() ----------
+void OptaButton::attachTrace(OptaTraceRecorder& recorder, uint8_t id) {
+  traceRecorder = &recorder;  // every input change and event from now on is logged
+  traceId = id;               // tagged with this id
+}
+
+// ---------- detachTrace() ----------
+void OptaButton::detachTrace() {
+  traceRecorder = nullptr;  // stop logging
+}
+#endif
+
+// ---------- attachQueue() ----------
+void OptaButton::attachQueue(OptaButtonEventQueue& queue, uint8_t id) {
+  eventQueue = &queue;  // every event from now on is also queued
+  eventId = id;         // tagged with this id
+}
+
+void OptaButton::detachQueue() {
+  eventQueue = nullptr;  // back to flags only
+}
+
+// ---------- useInterrupts() ----------
+bool OptaButton::useInterrupts(bool enable) {
+  if (!enable) {                        // back to plain polling
+    OptaEdgeCapture::detach(edgeSlot);  // safe even if never attached
+    edgeSlot = OPTA_EDGE_NONE;          // update() stops draining
+    return true;
+  }
+  if (edgeSlot != OPTA_EDGE_NONE) return true;                      // already capturing
+  if (inputMode == DefLab::ButtonInputMode::EXP_DIG) return false;  // expansion inputs can't interrupt
+  edgeSlot = OptaEdgeCapture::attach(inputID);                      // claim a slot and hook the pin
+  return edgeSlot != OPTA_EDGE_NONE;                                // false if no slot or no IRQ on this pin
+}
+
+bool OptaButton::isUsingInterrupts() const {
+  return edgeSlot != OPTA_EDGE_NONE;
+}
+
+// ---------- drainEdges() ----------
+// edgeClock: now is the hardware clock, so micros() dates each edge. Otherwise
+// now is the caller's tick: the newest edge is taken as happening at now and
+// the others keep their spacing, so the result depends only on the edges
+void OptaButton::drainEdges(uint32_t now, bool edgeClock) {
+  if (edgeSlot == OPTA_EDGE_NONE) return;  // polling only
+
+  OptaEdgeRecord edge;  // filled in by newest() / pop()
+  uint32_t refUs;       // the instant now stands for, on the ISR's clock
+  if (edgeClock) refUs = micros();
+  else if (OptaEdgeCapture::newest(edgeSlot, edge)) refUs = edge.timeUs;
+  else return;          // nothing captured
+
+  while (OptaEdgeCapture::pop(edgeSlot, edge)) {    // oldest edge first
+    int32_t sinceUs = int32_t(refUs - edge.timeUs);  // wrap-safe; < 0 if it arrived after refUs was taken
+    uint32_t age = (sinceUs > 0) ? uint32_t(sinceUs) / OPTA_BUTTON_US_PER_TICK : 0;  // how long ago, in ticks
+    uint32_t maxAge = ticksSinceLastSample(now);                     // rounding may put it before the last sample...
+    if (age > maxAge) age = maxAge;                                  // ...but never step backwards in time
+    processSample(decodeLevel(edge.level), now - age);               // same state machine, real edge time
+  }
+}
+
+// ---------- decodeLevel() ----------
+bool OptaButton::decodeLevel(int level) const {
+  bool raw = (inputMode == DefLab::ButtonInputMode::GPIO)
+               ? (level == LOW)    // active-LOW wiring
+               : (level == HIGH);  // active-HIGH wiring
+  return invertedLogic ? !raw : raw;  // apply inversion if needed
 }
 
 // Low-level raw input read with inversion applied
 bool OptaButton::readInput() {
+  OPTA_STATS(OptaButtonStats::countReadInput());
   bool raw = false;  // default to not pressed
+  if (provider) {                          // user input source
+    raw = provider->readChannel(inputID);  // true = active
+    return invertedLogic ? !raw : raw;     // apply inversion if needed
+  }
   switch (inputMode) {
     case DefLab::ButtonInputMode::GPIO:
-      raw = (digitalRead(inputID) == LOW);  // active-LOW wiring
-      break;
     case DefLab::ButtonInputMode::OPTA_CTL:
-      raw = (digitalRead(inputID) == HIGH);  // active-HIGH wiring
-      break;
+      return decodeLevel(digitalRead(inputID));  // polarity and inversion in one place
     case DefLab::ButtonInputMode::EXP_DIG:
-      // Only compile this on Opta targets
-#if OPTA == 1
-      // Gate expansion refresh so it happens at most once per loop pass
-      static uint32_t lastExpRefreshToken = 0;  // last token we refreshed on
-
-      // Loop through mechanical and solid‑state expansion
-      for (int i = 0; i < OPTA_CONTROLLER_MAX_EXPANSION_NUM; i++) {
-        Opta::DigitalMechExpansion mechExp = OptaController.getExpansion(i);
-        Opta::DigitalStSolidExpansion solidExp = OptaController.getExpansion(i);
-
-        if (mechExp) {  // if mechanical expansion present
-          if (g_optaExpRefreshToken != lastExpRefreshToken) {
-            mechExp.updateDigitalInputs();  // refresh its input state once per loop
-            lastExpRefreshToken = g_optaExpRefreshToken;
-          }
-          raw = mechExp.digitalRead(inputID);  // read channel state
-          break;                               // stop after first valid expansion match
-        }
-        if (solidExp) {  // if solid-state expansion present
-          if (g_optaExpRefreshToken != lastExpRefreshToken) {
-            solidExp.updateDigitalInputs();  // refresh its input state once per loop
-            lastExpRefreshToken = g_optaExpRefreshToken;
-          }
-          raw = solidExp.digitalRead(inputID);  // read channel state
-          break;                                // stop after first valid expansion match
+      {
+        // Coming back to a scan we already read means loop() wrapped around: start a new one
+        if (expScanSeen == uint8_t(OptaExpansionCache::getGeneration())) {
+          OptaExpansionCache::beginScan();  // every expansion may now be read once more
         }
+        expScanSeen = uint8_t(OptaExpansionCache::getGeneration());  // remember the scan we belong to
+
+        // Expansions were added or removed: look ours up again
+        if (topologySeen != OptaExpansionCache::getTopologyVersion()) resolveExpansion();
+
+        // Read our channel through the cache (one bus read per expansion per scan, shared)
+        raw = OptaExpansionCache::readChannel(expSlot, inputID);
       }
-#endif
       break;
   }
   return invertedLogic ? !raw : raw;  // apply inversion if needed
 }
 
-// Query functions return the flags set in update()
-bool OptaButton::isShortPressed() const {
-  return shortPressDetected;
+// Query functions (the is*() event flags live in OptaButtonCore)
+const char* OptaButton::getLabel() const {
+#if OPTA_BUTTON_LABELS
+  return name;
+#else
+  return "";  // labels compiled out
+#endif
 }
-bool OptaButton::isReleased() const {
-  return releaseDetected;
+
+#if OPTA_BUTTON_TAPS
+bool OptaButton::isDoubleTapped() const {
+  return doubleTapDetected;
 }
-bool OptaButton::isLongPressed() const {
-  return longPressDetected;
+bool OptaButton::isTripleTapped() const {
+  return tripleTapDetected;
 }
-bool OptaButton::isLongReleased() const {
-  return longReleaseDetected;
+#endif
+#if OPTA_BUTTON_GESTURES
+bool OptaButton::isPressBegun() const {
+  return pressBeginDetected;
 }
-bool OptaButton::isRepeating() const {
-  return repeatTriggered;
+OptaGesture OptaButton::getGesture() const {
+  return gesture;
 }
-const char* OptaButton::getLabel() const {
-  return name;
+uint8_t OptaButton::getGesturePressId() const {
+  return gesturePressId;
+}
+#endif
+uint8_t OptaButton::getPressId() const {
+  return pressId;
+}
+bool OptaButton::isIdle() const {
+#if OPTA_BUTTON_TAPS
+  if (taps) return false;  // an open sequence still has a deadline
+#endif
+#if OPTA_BUTTON_ADAPTIVE
+  if (bounceLearner && bounceLearner->isMeasuring()) return false;  // its burst closes on a quiet sample
+#endif
+  return OptaButtonCore<OptaButton>::isIdle();
+}
+
+// Timing settings (read by OptaButtonCore)
+uint16_t OptaButton::getDebounceMs() const {
+#if OPTA_BUTTON_ADAPTIVE
+  if (bounceLearner) return bounceLearner->getDebounceMs();  // learned window wins
+#endif
+  return debounceTime;
+}
+uint16_t OptaButton::getLongPressMs() const {
+  return longPressThreshold;
+}
+uint16_t OptaButton::getRepeatStartMs() const {
+  return repeatIntervalStart;
+}
+uint16_t OptaButton::getRepeatMinMs() const {
+  return repeatIntervalMin;
+}
+uint8_t OptaButton::getAccelRate() const {
+  return acceleration;
+}
+OptaDebounceMode OptaButton::getDebounceMode() const {
+  return debounceStrategy;
+}
+
+// ---------- Runtime tuning ----------
+void OptaButton::setDebounceMs(uint16_t ms) {
+  debounceTime = (ms < OPTA_BUTTON_DEBOUNCE_MAX_MS) ? ms : OPTA_BUTTON_DEBOUNCE_MAX_MS;  // the next edge uses it
+}
+void OptaButton::setLongPressMs(uint16_t ms) {
+  longPressThreshold = ms ? ms : 1;  // compared against the running hold time; 0 would fire with the press
+}
+void OptaButton::setRepeatStartMs(uint16_t ms) {
+  repeatIntervalStart = ms ? ms : 1;  // the next press starts from here; 0 would repeat every scan
+}
+void OptaButton::setRepeatMinMs(uint16_t ms) {
+  repeatIntervalMin = ms ? ms : 1;  // 0 would repeat every scan
+}
+void OptaButton::setAccelRate(uint8_t rate) {
+  acceleration = rate;
+}
+OptaButtonParams OptaButton::getParams() const {
+  OptaButtonParams p;
+  p.debounceMs = debounceTime;
+  p.longPressMs = longPressThreshold;
+  p.repeatStartMs = repeatIntervalStart;
+  p.repeatMinMs = repeatIntervalMin;
+  p.accelRate = acceleration;
+  return p;
+}
+void OptaButton::setParams(const OptaButtonParams& p) {
+  setDebounceMs(p.debounceMs);
+  setLongPressMs(p.longPressMs);
+  setRepeatStartMs(p.repeatStartMs);
+  setRepeatMinMs((p.repeatMinMs < p.repeatStartMs) ? p.repeatMinMs : p.repeatStartMs);  // never slower than the start
+  setAccelRate(p.accelRate);
+}
+
+#if OPTA_BUTTON_ADAPTIVE
+// ---------- Adaptive debounce ----------
+void OptaButton::setAdaptiveDebounce(OptaBounceLearner& learner) {
+  bounceLearner = &learner;  // its window replaces debounceTime from the next sample on
+}
+void OptaButton::clearAdaptiveDebounce() {
+  bounceLearner = nullptr;  // debounceTime again
+}
+OptaBounceLearner* OptaButton::getBounceLearner() const {
+  return bounceLearner;
+}
+#endif
+
+// ---------- learnBounce() ----------
+void OptaButton::learnBounce(bool edge, uint32_t now) {
+#if OPTA_BUTTON_ADAPTIVE
+  if (bounceLearner) bounceLearner->observe(edge, now);  // one compare per sample when idle
+#else
+  (void)edge;  // learner compiled out
+  (void)now;
+#endif
+}
+
+// ---------- Repeat curve ----------
+void OptaButton::setRepeatCurve(const OptaRepeatCurve& curve) {
+  repeatCurve = &curve;  // takes effect from the next long press on
+}
+void OptaButton::clearRepeatCurve() {
+  repeatCurve = nullptr;  // linear staircase again
+}
+const OptaRepeatCurve* OptaButton::getRepeatCurve() const {
+  return repeatCurve;
 }
 
 // OptaButton.cpp
@@ -13,6 +13,9 @@
     • Tap (short press) event
     • Hold (long press) event
     • Hold-and-repeat with gradual acceleration
+    • Double / triple tap, optionally with the short press held back (setMultiTap())
+    • Optional press-begin and gesture events for instant feedback plus a
+      later classification of the same press (setGestureEvents())
 
   Interface scenarios
     • Long press to enter a special mode
@@ -48,6 +51,11 @@
 #include <Arduino.h>        // include Arduino core
 #include <DefLab_Common.h>  // shared enums + debug helpers
 
+#include "OptaButtonEvents.h"  // event types and the optional event queue
+#include "OptaButtonCore.h"    // shared debounce / long-press / repeat state machine
+#include "OptaInputProvider.h"  // user-supplied input sources
+#include "OptaBounceLearner.h"  // optional adaptive debounce
+
 // ---------- PLATFORM Control ----------
 #ifndef OPTA
 // Auto‑detect common cores
@@ -60,6 +68,38 @@
 #endif
 #endif
 
+// ---------- FEATURE Control ----------
+// Set these to 0 in your build flags to save RAM on small AVR boards
+#ifndef OPTA_BUTTON_LABELS
+#define OPTA_BUTTON_LABELS 1  // 0 = no label pointer per button, getLabel() returns ""
+#endif
+#ifndef OPTA_BUTTON_CALLBACKS
+#define OPTA_BUTTON_CALLBACKS 1  // 0 = no onShortPress() etc. (saves 5 bytes per slot on AVR)
+#endif
+#ifndef OPTA_BUTTON_CALLBACK_SLOTS
+#if defined(ARDUINO_ARCH_AVR)
+#define OPTA_BUTTON_CALLBACK_SLOTS 3  // handlers one button can hold (each takes one event type)
+#else
+#define OPTA_BUTTON_CALLBACK_SLOTS 10  // one per event type
+#endif
+#endif
+#ifndef OPTA_BUTTON_TRACE
+#define OPTA_BUTTON_TRACE 1  // 0 = no attachTrace() (saves 3 bytes per button on AVR)
+#endif
+#ifndef OPTA_BUTTON_TAPS
+#define OPTA_BUTTON_TAPS 1  // 0 = no setMultiTap(), double / triple tap (saves 6 bytes per button on AVR)
+#endif
+#ifndef OPTA_BUTTON_GESTURES
+#define OPTA_BUTTON_GESTURES 1  // 0 = no setGestureEvents(), PRESS_BEGIN / GESTURE (saves 3 bytes per button on AVR)
+#endif
+#ifndef OPTA_BUTTON_ADAPTIVE
+#define OPTA_BUTTON_ADAPTIVE 1  // 0 = no setAdaptiveDebounce() (saves 2 bytes per button on AVR)
+#endif
+// OPTA_BUTTON_MICROS (OptaButtonClock.h) switches every timer to micros()
+#ifndef OPTA_BUTTON_SCAN_US
+#define OPTA_BUTTON_SCAN_US 250  // micros timebase only: minimum us between scans
+#endif
+
 #if OPTA == 1
 #include <OptaBlue.h>  // Required for expansion support
 #endif
@@ -76,9 +116,34 @@
 // ---------- OptaButton CLASS ----------
 
 // Define timing variables
-static constexpr uint16_t LOOP_INTERVAL_MS = 1;  // minimum ms between updates
+static constexpr uint16_t LOOP_INTERVAL_MS = 1;                      // minimum ms between updates
+static constexpr uint32_t LOOP_INTERVAL_US = OPTA_BUTTON_SCAN_US;    // minimum us between updates (micros timebase)
+static constexpr uint32_t LOOP_INTERVAL_TICKS = OPTA_BUTTON_MICROS   // the gate actually used, in ticks
+                                                  ? LOOP_INTERVAL_US
+                                                  : LOOP_INTERVAL_MS;
+
+// EXP_DIG expansion index meaning "use the first digital expansion found"
+static constexpr uint8_t OPTA_EXP_ANY = 0xFF;
+
+// Longest debounce setDebounceMs() accepts: a contact that needs more is stuck, not bouncing
+static constexpr uint16_t OPTA_BUTTON_DEBOUNCE_MAX_MS = 1000;
+
+// Every runtime-tunable timing setting of one button (see setParams(), OptaButtonProfile)
+struct OptaButtonParams {
+  uint16_t debounceMs;     // ms to ignore bounce after edge
+  uint16_t longPressMs;    // ms to hold before long press fires
+  uint16_t repeatStartMs;  // initial delay between repeats
+  uint16_t repeatMinMs;    // fastest delay when accelerating
+  uint8_t accelRate;       // how much to speed up per second
+};
+
+class OptaButtonGroup;  // batch poller, see OptaButtonGroup.h
+class OptaButton;       // forward declaration for the handler type
 
-class OptaButton {
+// Callback signature: the button that fired, plus the context pointer you registered
+typedef void (*OptaButtonHandler)(OptaButton& button, void* context);
+
+class OptaButton : public OptaButtonCore<OptaButton> {
 public:
   // ---------- Constructor ----------
   OptaButton(
@@ -90,56 +155,240 @@ public:
     uint16_t longPressMs = 800,    // ms to hold before long press fires
     uint16_t repeatStartMs = 100,  // initial delay between repeats
     uint16_t repeatMinMs = 8,      // fastest delay when accelerating
-    uint8_t accelRate = 100        // how much to speed up per second
+    uint8_t accelRate = 100,       // how much to speed up per second
+    OptaDebounceMode debounceMode = OptaDebounceMode::IMMEDIATE  // how bounce is filtered
+  );                               // end constructor
+
+  // ---------- Constructor (EXP_DIG on a specific expansion) ----------
+  OptaButton(
+    DefLab::ButtonInputMode mode,  // EXP_DIG (other modes ignore expansionIndex)
+    uint8_t expansionIndex,        // 0 = first expansion on the bus, 1 = second, ...
+    uint8_t channel,               // input channel on that expansion
+    const char* label,             // human-readable name for debugging
+    uint16_t debounceMs = 20,      // ms to ignore bounce after edge
+    bool inverted = false,         // true if LOW=pressed instead of HIGH
+    uint16_t longPressMs = 800,    // ms to hold before long press fires
+    uint16_t repeatStartMs = 100,  // initial delay between repeats
+    uint16_t repeatMinMs = 8,      // fastest delay when accelerating
+    uint8_t accelRate = 100,       // how much to speed up per second
+    OptaDebounceMode debounceMode = OptaDebounceMode::IMMEDIATE  // how bounce is filtered
+  );                               // end constructor
+
+  // ---------- Constructor (your own input source, see OptaInputProvider.h) ----------
+  OptaButton(
+    OptaInputProvider& provider,   // where the input comes from (must outlive the button)
+    uint8_t channel,               // channel number handed to provider.readChannel()
+    const char* label,             // human-readable name for debugging
+    uint16_t debounceMs = 20,      // ms to ignore bounce after edge
+    bool inverted = false,         // true if the provider reports "active" for released
+    uint16_t longPressMs = 800,    // ms to hold before long press fires
+    uint16_t repeatStartMs = 100,  // initial delay between repeats
+    uint16_t repeatMinMs = 8,      // fastest delay when accelerating
+    uint8_t accelRate = 100,       // how much to speed up per second
+    OptaDebounceMode debounceMode = OptaDebounceMode::IMMEDIATE  // how bounce is filtered
   );                               // end constructor
 
   void begin();   // call in setup() to configure hardware for the chosen mode
   void update();  // call in loop() to handle timing and events
+  void update(uint32_t nowTicks);  // one scan at a time you supply (timer ISR, PLC cycle, simulation)
+
+  // ---------- Interrupt Edge Capture (GPIO / OPTA_CTL only) ----------
+  bool useInterrupts(bool enable = true);  // call after begin(); false if this pin/mode can't
+  bool isUsingInterrupts() const;          // true while edges are captured by an ISR
+
+  // ---------- Event Queue ----------
+  void attachQueue(OptaButtonEventQueue& queue, uint8_t id);  // also push every event, tagged with id
+  void detachQueue();                                         // back to the is*() flags only
+
+#if OPTA_BUTTON_TRACE
+  // ---------- Trace Recorder (see OptaTraceRecorder.h) ----------
+  void attachTrace(OptaTraceRecorder& recorder, uint8_t id);  // log inputs and events, tagged with id
+  void detachTrace();                                         // stop logging
+#endif
+
+#if OPTA_BUTTON_CALLBACKS
+  // ---------- Callbacks (called from inside update() as events fire) ----------
+  // Each event type with a handler takes one of OPTA_BUTTON_CALLBACK_SLOTS; false = all slots in use
+  bool onShortPress(OptaButtonHandler fn, void* context = nullptr);   // same moment as isShortPressed()
+  bool onRelease(OptaButtonHandler fn, void* context = nullptr);      // same moment as isReleased()
+  bool onLongPress(OptaButtonHandler fn, void* context = nullptr);    // same moment as isLongPressed()
+  bool onLongRelease(OptaButtonHandler fn, void* context = nullptr);  // same moment as isLongReleased()
+  bool onRepeat(OptaButtonHandler fn, void* context = nullptr);       // same moment as isRepeating()
+#if OPTA_BUTTON_TAPS
+  bool onDoubleTap(OptaButtonHandler fn, void* context = nullptr);    // same moment as isDoubleTapped()
+  bool onTripleTap(OptaButtonHandler fn, void* context = nullptr);    // same moment as isTripleTapped()
+#endif
+#if OPTA_BUTTON_GESTURES
+  bool onPressBegin(OptaButtonHandler fn, void* context = nullptr);   // same moment as isPressBegun()
+  bool onGesture(OptaButtonHandler fn, void* context = nullptr);      // same moment as getGesture() != NONE
+#endif
+  bool on(OptaButtonEventType type, OptaButtonHandler fn, void* context = nullptr);  // any type; nullptr removes
+#endif
+
+#if OPTA_BUTTON_TAPS
+  // ---------- Multi-Tap ----------
+  // Taps are presses released before the long press; the next one must start within windowMs of the last release
+  void setMultiTap(uint16_t windowMs, uint8_t maxTaps = 2, bool deferShortPress = false);  // windowMs 0 = off
+  bool isDoubleTapped() const;  // true if two taps just completed
+  bool isTripleTapped() const;  // true if three taps just completed (maxTaps = 3)
+#endif
+
+#if OPTA_BUTTON_GESTURES
+  // ---------- Gesture Events ----------
+  // PRESS_BEGIN goes out on the debounced press edge, even while taps or chords hold SHORT_PRESS back;
+  // one GESTURE per press (or tap sequence) follows once it is classified, tagged with the same press id
+  void setGestureEvents(bool enable = true);
+  bool isPressBegun() const;        // true if a press just began (gesture events on)
+  OptaGesture getGesture() const;   // classification made this scan, or NONE
+  uint8_t getGesturePressId() const;  // press id the latest classification belongs to
+#endif
+  uint8_t getPressId() const;       // id of the latest press (counts up, wraps at 255; queued events carry it)
 
   // ---------- Query Functions ----------
-  bool isShortPressed() const;   // true if just pressed (first ms)
-  bool isReleased() const;       // true if just released
-  bool isLongPressed() const;    // true if long-press just started
-  bool isLongReleased() const;   // true if long-press just ended
-  bool isRepeating() const;      // true for each repeat during hold
+  // isShortPressed(), isReleased(), isLongPressed(), isLongReleased() and
+  // isRepeating() come from OptaButtonCore
   const char* getLabel() const;  // return the button name
+  bool isIdle() const;           // released, settled and no tap sequence open
+
+  // ---------- Timing Settings ----------
+  uint16_t getDebounceMs() const;     // ms to ignore bounce after edge
+  uint16_t getLongPressMs() const;    // ms to hold before long press fires
+  uint16_t getRepeatStartMs() const;  // initial delay between repeats
+  uint16_t getRepeatMinMs() const;    // fastest delay when accelerating
+  uint8_t getAccelRate() const;       // ms the repeat delay shrinks per second
+  OptaDebounceMode getDebounceMode() const;  // IMMEDIATE, STABLE or INTEGRATOR
+
+  // Runtime tuning: takes effect from the next edge / press on, no begin() needed.
+  // 0 ms long press / repeat times become 1, debounce is capped at OPTA_BUTTON_DEBOUNCE_MAX_MS,
+  // and setParams() also keeps repeatMinMs at or below repeatStartMs
+  void setDebounceMs(uint16_t ms);
+  void setLongPressMs(uint16_t ms);
+  void setRepeatStartMs(uint16_t ms);
+  void setRepeatMinMs(uint16_t ms);
+  void setAccelRate(uint8_t rate);
+  OptaButtonParams getParams() const;             // all of the above at once
+  void setParams(const OptaButtonParams& params);  //
+
+#if OPTA_BUTTON_ADAPTIVE
+  // ---------- Adaptive Debounce (see OptaBounceLearner.h) ----------
+  void setAdaptiveDebounce(OptaBounceLearner& learner);  // learn the window (learner must outlive the button)
+  void clearAdaptiveDebounce();                          // back to the fixed debounceMs
+  OptaBounceLearner* getBounceLearner() const;           // current learner, or nullptr
+#endif
+
+  // ---------- Repeat Curve (see OptaRepeatCurve.h) ----------
+  void setRepeatCurve(const OptaRepeatCurve& curve);  // table-driven acceleration (curve must outlive the button)
+  void clearRepeatCurve();                            // back to the linear accelRate staircase
+  const OptaRepeatCurve* getRepeatCurve() const;      // current curve, or nullptr for linear
 
 private:
-  // Configuration values stored once
+  // Configuration values (the timings can be retuned at runtime, see setParams())
   const DefLab::ButtonInputMode inputMode;  // which hardware mode
   const uint8_t inputID;                    // pin or channel
+  const uint8_t expansionID;                // EXP_DIG expansion index (or OPTA_EXP_ANY)
+#if OPTA_BUTTON_LABELS
   const char* name;                         // label for prints
-  const uint16_t debounceTime;              // how long to wait after edge
+#endif
+  uint16_t debounceTime;                    // how long to wait after edge
   const bool invertedLogic;                 // flip raw HIGH/LOW if needed
-  const uint16_t longPressThreshold;        // how long to hold for long press
-  const uint16_t repeatIntervalStart;       // starting interval for repeats
-  const uint16_t repeatIntervalMin;         // fastest interval
-  uint16_t currentRepeatInterval;           // running interval that shrinks
+  uint16_t longPressThreshold;              // how long to hold for long press
+  uint16_t repeatIntervalStart;             // starting interval for repeats
+  uint16_t repeatIntervalMin;               // fastest interval
   uint8_t acceleration;                     // speed-up in ms per second
+  const OptaDebounceMode debounceStrategy;  // how bounce is filtered
+  const OptaRepeatCurve* repeatCurve;       // nullptr = linear acceleration
+#if OPTA_BUTTON_ADAPTIVE
+  OptaBounceLearner* bounceLearner;         // nullptr = fixed debounceTime
+#endif
+
+  OptaInputProvider* provider;  // user input source, or nullptr for the built-in modes
+
+  // Runtime variables updated each loop (the state machine's own live in OptaButtonCore)
+  OptaButtonStamp lastUpdateTime;  // last tick when update() ran
+
+  // EXP_DIG bookkeeping (see OptaExpansionCache)
+  uint8_t expScanSeen;   // last expansion scan this button read in (low byte)
+  uint8_t expSlot;       // resolved expansion index, or OPTA_EXP_NONE
+  uint8_t topologySeen;  // topology version expSlot was resolved against
+
+  // Interrupt capture slot (see OptaEdgeCapture), or OPTA_EDGE_NONE when polling
+  uint8_t edgeSlot;
+
+  // Chord bookkeeping, driven by OptaButtonGroup::setChords()
+  bool holdShortPress : 1;  // capture SHORT_PRESS instead of reporting it right away
+  bool shortPending : 1;    // a captured SHORT_PRESS waits to be flushed or dropped
+  bool chordConsumed : 1;   // this press belongs to a chord: only its RELEASE is reported
 
-  // Runtime variables updated each loop
-  uint32_t lastUpdateTime;   // last millis() when update() ran
-  uint32_t edgeTime;         // millis() when last edge occurred
-  uint32_t lastRepeatTime;   // millis() when last repeat event fired
-  uint32_t lastAccelUpdate;  // millis() when last acceleration step happened
+#if OPTA_BUTTON_TAPS
+  // Multi-tap bookkeeping (see setMultiTap())
+  uint16_t tapWindow;               // ms allowed between a release and the next press, 0 = off
+  OptaButtonStamp tapTime;          // tick of the last counted tap's release
+  uint8_t taps : 2;                 // taps counted in the open sequence
+  uint8_t tapLimit : 2;             // 2 or 3: report as soon as this many are counted
+  bool tapDeferShort : 1;           // hold SHORT_PRESS back until the sequence shows it was a single tap
+  bool tapDown : 1;                 // the current press started as a tap
+  bool doubleTapDetected : 1;       // one-shot flags, cleared with the core's
+  bool tripleTapDetected : 1;       //
+  uint8_t tapFirstId;               // press id that opened the sequence
+#endif
+
+  uint8_t pressId;  // counts up on every press; queued events carry it
+
+#if OPTA_BUTTON_GESTURES
+  // Gesture bookkeeping (see setGestureEvents())
+  uint8_t gesturePressId;           // press the latest classification belongs to
+  OptaGesture gesture;              // one-shot: classification made this scan
+  bool gestureEvents : 1;           // send PRESS_BEGIN / GESTURE
+  bool pressBeginDetected : 1;      // one-shot, cleared with the core's
+  bool pressClassified : 1;         // the current press already has its GESTURE
+#endif
 
-  bool rawState;         // last raw readInput() value
-  bool debouncing;       // true until debounceTime has passed
-  bool currentPressed;   // egde-triggerd state (true if pressed)
-  bool longPressActive;  // true after longPressDetected until release
+  // Optional event queue and the id our events carry
+  OptaButtonEventQueue* eventQueue;
+  uint8_t eventId;
 
-  // These flags are cleared each update() then set when events occur
-  bool shortPressDetected;   // set true on press edge
-  bool releaseDetected;      // set true on release edge
-  bool longPressDetected;    // set true when entering long-press
-  bool longReleaseDetected;  // set true when leaving long-press on release
-  bool repeatTriggered;      // set true on each repeat interval
+#if OPTA_BUTTON_TRACE
+  // Optional flight recorder and the id our records carry
+  OptaTraceRecorder* traceRecorder;
+  uint8_t traceId;
+#endif
 
-  // Guard so longPressDetected only fires once per physical press
-  bool longPressReported;
+#if OPTA_BUTTON_CALLBACKS
+  // Optional per-event callbacks (plain function pointer + context, no std::function).
+  // Sparse: a slot only costs RAM for an event type that is actually handled
+  struct Callback {
+    OptaButtonHandler fn;      // nullptr = free slot
+    void* context;             // handed back to fn
+    OptaButtonEventType type;  // which event this slot handles
+  };
+  Callback callbacks[OPTA_BUTTON_CALLBACK_SLOTS];  // searched in order, a handful at most
+#endif
 
   // ---------- Helper Methods ----------
-  bool readInput();  // low-level read of the hardware, applies inversion
+  bool readInput();                                            // low-level read of the hardware, applies inversion
+  bool decodeLevel(int level) const;                           // pin level to "pressed" for this mode and wiring
+  void scan(uint32_t now, bool edgeClock);                     // one scan; edgeClock = date edges by micros()
+  void drainEdges(uint32_t now, bool edgeClock);               // feed ISR-captured edges to the state machine
+  void resolveExpansion();                                     // look up expSlot once, not every poll
+  void dispatchEvent(OptaButtonEventType type, uint32_t now);  // filter for chords, then deliverEvent()
+  void deliverEvent(OptaButtonEventType type, uint32_t now);   // count taps, then sendEvent()
+  void sendEvent(OptaButtonEventType type, uint32_t now, uint8_t id);  // queue it for press id, call the handler
+  void emitFor(OptaButtonEventType type, uint8_t id, uint32_t now);    // count, trace and send for press id
+  void flushShortPress(uint32_t now);                          // report a captured SHORT_PRESS after all
+#if OPTA_BUTTON_TAPS
+  bool trackTaps(OptaButtonEventType type, uint32_t now);      // false = swallow this event
+  void resolveTaps(uint32_t now);                              // report what the sequence added up to
+#endif
+  void checkTaps(uint32_t now);                                // close the sequence once the window runs out
+  void beginPress(uint32_t now);                               // new press id, PRESS_BEGIN
+  void classify(OptaGesture g, uint8_t id, uint32_t now);      // send one GESTURE
+  void consumeByChord(uint32_t now);                           // the group matched a chord with this press
+  void clearEvents();                                          // core flags plus the tap flags
+  void traceRecord(OptaTraceKind kind, uint8_t value, uint32_t now);  // log to the recorder, if attached
+  void learnBounce(bool edge, uint32_t now);                          // feed the learner, if attached
+
+  friend class OptaButtonCore<OptaButton>;  // calls dispatchEvent(), traceRecord() and learnBounce()
+  friend class OptaButtonGroup;             // the group feeds samples from its own scan snapshot
 };
 
 // OptaButton.h
@@ -0,0 +1,142 @@
+/*
+ * OptaButtonBridge.cpp
+ * Change-only, coalesced and rate-limited frames of a group's button state
+ */
+
+#include "OptaButtonBridge.h"  // include our header
+
+// Constructor implementation
+OptaButtonBridge::OptaButtonBridge(OptaButtonGroup& group, uint16_t coalesceMs, uint16_t minIntervalMs, uint16_t heartbeatMs)
+  : buttons(group),                                                   // save the group
+    coalesce(uint32_t(coalesceMs) * OPTA_BUTTON_TICKS_PER_MS),        // settings in ticks of the active timebase
+    minInterval(uint32_t(minIntervalMs) * OPTA_BUTTON_TICKS_PER_MS),  //
+    heartbeat(uint32_t(heartbeatMs) * OPTA_BUTTON_TICKS_PER_MS),      //
+    state(),                                                          // nothing published yet
+    pendingPressed(0),                                                // nothing collected yet
+    pendingRepeated(0),                                               //
+    pendingRepeats(0),                                                //
+    lastDown(0),                                                      // all released
+    lastLong(0),                                                      //
+    dirtySince(0),                                                    //
+    lastPublish(0),                                                   //
+    published(0),                                                     // no frames yet
+    coalesced(0),                                                     //
+    dirty(false),                                                     //
+    requested(true)                                                   // the first poll() sends the initial state
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- poll() ----------
+bool OptaButtonBridge::poll() {
+  return poll(optaButtonNow());
+}
+
+// ---------- poll(nowTicks) ----------
+bool OptaButtonBridge::poll(uint32_t now) {
+  // What this scan added
+  uint32_t down = buttons.getDebouncedMask();
+  uint32_t held = buttons.getLongPressMask();
+  uint32_t repeatedNow = 0;
+  for (uint8_t i = 0; i < buttons.size(); i++) {
+    if (!buttons.getButton(i).isRepeating()) continue;
+    repeatedNow |= (1UL << i);
+    if (pendingRepeats != 0xFFFF) pendingRepeats++;  // saturate rather than wrap
+  }
+  uint32_t pressedNow = down & ~lastDown;  // debounced down edges (also chord members and deferred taps)
+  bool news = (down != lastDown) || (held != lastLong) || repeatedNow;
+  lastDown = down;
+  lastLong = held;
+  pendingPressed |= pressedNow;    // sticky until the next frame: a quick tap is never lost
+  pendingRepeated |= repeatedNow;  //
+
+  if (news) {
+    if (dirty) {
+      coalesced++;  // rides along with the change already waiting
+    } else {
+      dirty = true;
+      dirtySince = now;  // the coalescing window starts with the first change
+    }
+  }
+
+  // Send when asked to, when a change has waited its window and the rate limit allows, or for the heartbeat
+  bool due = requested
+             || (dirty && now - dirtySince >= coalesce && now - lastPublish >= minInterval)
+             || (heartbeat && now - lastPublish >= heartbeat);
+  if (!due) return false;
+
+  // Build the frame and start collecting the next one
+  state.down = down;
+  state.longHeld = held;
+  state.pressedSince = pendingPressed;
+  state.repeatedSince = pendingRepeated;
+  state.repeats = pendingRepeats;
+  state.sequence++;
+  pendingPressed = 0;
+  pendingRepeated = 0;
+  pendingRepeats = 0;
+  dirty = false;
+  requested = false;
+  lastPublish = now;
+  published++;
+  return true;
+}
+
+// ---------- requestPublish() ----------
+void OptaButtonBridge::requestPublish() {
+  requested = true;  // bypasses coalescing and the rate limit once
+}
+
+// ---------- toRegisters() ----------
+void OptaButtonBridge::toRegisters(uint16_t* regs) const {
+  regs[0] = uint16_t(state.down);  // each mask low word first
+  regs[1] = uint16_t(state.down >> 16);
+  regs[2] = uint16_t(state.longHeld);
+  regs[3] = uint16_t(state.longHeld >> 16);
+  regs[4] = uint16_t(state.pressedSince);
+  regs[5] = uint16_t(state.pressedSince >> 16);
+  regs[6] = uint16_t(state.repeatedSince);
+  regs[7] = uint16_t(state.repeatedSince >> 16);
+  regs[8] = state.repeats;
+  regs[9] = state.sequence;
+}
+
+// ---------- writeBinary() ----------
+void OptaButtonBridge::writeBinary(Print& out) const {
+  uint16_t regs[OPTA_BRIDGE_REGISTERS];
+  toRegisters(regs);  // same layout, byte by byte
+  for (uint8_t i = 0; i < OPTA_BRIDGE_REGISTERS; i++) {
+    out.write(uint8_t(regs[i]));
+    out.write(uint8_t(regs[i] >> 8));
+  }
+}
+
+// ---------- writeJson() ----------
+void OptaButtonBridge::writeJson(Print& out) const {
+  out.print(F("{\"down\":"));
+  out.print(state.down);
+  out.print(F(",\"long\":"));
+  out.print(state.longHeld);
+  out.print(F(",\"pressed\":"));
+  out.print(state.pressedSince);
+  out.print(F(",\"repeated\":"));
+  out.print(state.repeatedSince);
+  out.print(F(",\"repeats\":"));
+  out.print(state.repeats);
+  out.print(F(",\"seq\":"));
+  out.print(state.sequence);
+  out.print('}');
+}
+
+// Query functions
+const OptaBridgeState& OptaButtonBridge::getState() const {
+  return state;
+}
+uint32_t OptaButtonBridge::getPublished() const {
+  return published;
+}
+uint32_t OptaButtonBridge::getCoalesced() const {
+  return coalesced;
+}
+
+// OptaButtonBridge.cpp
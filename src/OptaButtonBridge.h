@@ -0,0 +1,110 @@
+/*
+  NAME:
+    OptaButtonBridge — Publish a group's button state to SCADA on change only
+
+  Purpose
+  Mirroring buttons to a PLC or SCADA by writing one Modbus register per
+  button every loop costs a network write per button per loop, most of them
+  repeating what the other side already knows. The bridge packs the whole
+  group into one frame and tells the sketch when that frame is worth
+  sending:
+    • Bitmasks: down, held past the long press, pressed since the last
+      frame (so a tap shorter than the window is never lost), repeated
+      since the last frame, plus a repeat count and a frame counter
+    • Only on change: nothing is sent while nothing happens
+    • Coalescing: a change waits coalesceMs so the edges around it
+      (the other buttons of a combination, a release) go out in one frame
+    • Rate limit: at most one frame per minIntervalMs, however fast a
+      hold-repeat runs (repeatMinMs = 8 would otherwise mean 125 frames/s)
+    • Optional heartbeat: resend the frame every heartbeatMs anyway
+
+  The bridge does not talk to the network itself. It fills Modbus register
+  images and writes MQTT payloads to any Print, so it works with
+  ArduinoModbus, ArduinoMqttClient or anything else, without depending on
+  them.
+
+  How to Use
+    OptaButtonBridge bridge(panel, 20, 100);  // coalesce 20 ms, at most 10 frames/s
+    uint16_t regs[OPTA_BRIDGE_REGISTERS];
+
+    void loop() {
+      panel.update();
+      if (bridge.poll()) {        // once per update(), true = send a frame now
+        bridge.toRegisters(regs);  // Modbus: write regs as one block
+        // or: mqtt.beginMessage("panel/buttons"); bridge.writeJson(mqtt); mqtt.endMessage();
+      }
+    }
+
+  The first poll() always returns true, so the other side starts from the
+  real state.
+
+  Register layout (low word first)
+    0-1 down   2-3 long   4-5 pressed since   6-7 repeated since
+    8 repeat count since the last frame   9 frame counter
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>          // Print, fixed-width integer types
+#include "OptaButtonGroup.h"  // the buttons we mirror
+
+// Holding registers toRegisters() fills
+static constexpr uint8_t OPTA_BRIDGE_REGISTERS = 10;
+
+// Bytes writeBinary() sends
+static constexpr uint8_t OPTA_BRIDGE_BINARY_SIZE = 20;
+
+// One published frame (bit i = button i of the group)
+struct OptaBridgeState {
+  uint32_t down;           // buttons down right now (debounced)
+  uint32_t longHeld;       // buttons held past their long press right now
+  uint32_t pressedSince;   // went down at least once since the previous frame
+  uint32_t repeatedSince;  // repeated at least once since the previous frame
+  uint16_t repeats;        // REPEAT events since the previous frame, all buttons (saturates)
+  uint16_t sequence;       // counts frames (wraps): the other side can spot missed ones
+};
+
+class OptaButtonBridge {
+public:
+  // ---------- Constructor ----------
+  OptaButtonBridge(
+    OptaButtonGroup& group,        // buttons to mirror (must outlive the bridge)
+    uint16_t coalesceMs = 20,      // a change waits this long for the edges around it
+    uint16_t minIntervalMs = 100,  // and frames are at least this far apart
+    uint16_t heartbeatMs = 0       // resend this often even without changes (0 = never)
+  );                               // end constructor
+
+  bool poll();                   // call once after every group update(); true = send getState() now
+  bool poll(uint32_t nowTicks);  // same, at a time you supply (see update(nowTicks))
+  void requestPublish();         // send on the next poll(), e.g. after a reconnect
+
+  // ---------- The Frame ----------
+  const OptaBridgeState& getState() const;  // last frame poll() returned true for
+  void toRegisters(uint16_t* regs) const;   // OPTA_BRIDGE_REGISTERS holding registers
+  void writeJson(Print& out) const;         // {"down":5,"long":1,"pressed":5,"repeated":1,"repeats":12,"seq":7}
+  void writeBinary(Print& out) const;       // OPTA_BRIDGE_BINARY_SIZE bytes, register order, little-endian
+
+  // ---------- Query Functions ----------
+  uint32_t getPublished() const;  // frames handed out
+  uint32_t getCoalesced() const;  // changes that rode along in a frame instead of getting their own
+
+private:
+  OptaButtonGroup& buttons;    // group to mirror
+  const uint32_t coalesce;     // ticks a change waits
+  const uint32_t minInterval;  // ticks between frames
+  const uint32_t heartbeat;    // ticks between unchanged frames, 0 = off
+  OptaBridgeState state;       // the frame last published
+  uint32_t pendingPressed;     // pressedSince being collected
+  uint32_t pendingRepeated;    // repeatedSince being collected
+  uint16_t pendingRepeats;     // repeats being collected
+  uint32_t lastDown;           // down mask at the previous poll()
+  uint32_t lastLong;           // long mask at the previous poll()
+  uint32_t dirtySince;         // tick the oldest unpublished change arrived
+  uint32_t lastPublish;        // tick of the last frame
+  uint32_t published;          // getPublished()
+  uint32_t coalesced;          // getCoalesced()
+  bool dirty;                  // something new since the last frame
+  bool requested;              // send on the next poll() (set at start: the initial frame)
+};
+
+// OptaButtonBridge.h
@@ -0,0 +1,15 @@
+/*
+ * OptaButtonClock.cpp
+ * Storage for the optional replacement clock
+ */
+
+#include "OptaButtonClock.h"  // include our header
+
+OptaButtonClockSource optaButtonClockSource = nullptr;  // hardware clock until replaced
+
+// ---------- optaButtonUseClock() ----------
+void optaButtonUseClock(OptaButtonClockSource source) {
+  optaButtonClockSource = source;  // nullptr goes back to millis() / micros()
+}
+
+// OptaButtonClock.cpp
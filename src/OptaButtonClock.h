@@ -0,0 +1,66 @@
+/*
+  NAME:
+    OptaButtonClock — The timebase every button and group runs on
+
+  Purpose
+  All button timing is done in "ticks" of one shared clock:
+    • Default: ticks are milliseconds from millis(), kept as 16-bit stamps
+      (wrap-safe for any interval up to 65 s, and half the RAM)
+    • OPTA_BUTTON_MICROS = 1: ticks are microseconds from micros(), kept as
+      32-bit stamps (wrap-safe for any interval up to 71 minutes)
+
+  The micros timebase is for fast jog inputs and short-pulse sensors wired
+  as buttons: the scan can then run faster than once per ms (see
+  LOOP_INTERVAL_US) and debounce, long-press and repeat timing resolve to the
+  microsecond. Every setting is still given in milliseconds; optaButtonTicks()
+  converts it to the active timebase.
+
+  Every comparison is written as OptaButtonStamp(now - stamp) >= interval,
+  which stays correct when the clock wraps around.
+
+  Replacing the clock
+  optaButtonUseClock(fn) makes every button read time from fn() instead of
+  millis() / micros(), e.g. a simulated clock that replays a recorded trace
+  faster than real time. fn must return ticks of the active timebase. Pass
+  nullptr to go back to the hardware clock.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>  // millis(), micros() and fixed-width integer types
+
+#ifndef OPTA_BUTTON_MICROS
+#define OPTA_BUTTON_MICROS 0  // 1 = micros() timebase with 32-bit stamps (2 more bytes per timer)
+#endif
+
+#if OPTA_BUTTON_MICROS
+typedef uint32_t OptaButtonStamp;                           // micros(); compare with OptaButtonStamp(now - stamp)
+static constexpr uint32_t OPTA_BUTTON_TICKS_PER_MS = 1000;  // ticks in one millisecond
+#else
+typedef uint16_t OptaButtonStamp;                        // low 16 bits of millis(); compare with OptaButtonStamp(now - stamp)
+static constexpr uint32_t OPTA_BUTTON_TICKS_PER_MS = 1;  // ticks in one millisecond
+#endif
+
+static constexpr uint32_t OPTA_BUTTON_US_PER_TICK = 1000 / OPTA_BUTTON_TICKS_PER_MS;  // for micros() edge times
+
+// Optional replacement clock (nullptr = millis() / micros())
+typedef uint32_t (*OptaButtonClockSource)();
+extern OptaButtonClockSource optaButtonClockSource;
+void optaButtonUseClock(OptaButtonClockSource source);
+
+// Current time in ticks (full 32 bits; buttons keep the low bits they need)
+inline uint32_t optaButtonNow() {
+  if (optaButtonClockSource) return optaButtonClockSource();  // simulated time
+#if OPTA_BUTTON_MICROS
+  return micros();
+#else
+  return millis();
+#endif
+}
+
+// A millisecond setting expressed in ticks of the active timebase
+inline OptaButtonStamp optaButtonTicks(uint32_t ms) {
+  return OptaButtonStamp(ms * OPTA_BUTTON_TICKS_PER_MS);
+}
+
+// OptaButtonClock.h
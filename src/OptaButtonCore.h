@@ -0,0 +1,315 @@
+/*
+  NAME:
+    OptaButtonCore — The debounce / long-press / repeat state machine
+
+  Purpose
+  OptaButton and OptaButtonT read their inputs differently and keep their
+  settings in different places (constructor arguments vs template
+  parameters), but they should behave exactly the same. This template holds
+  the part they share:
+    • The runtime state (edges, timers, one-shot event flags)
+    • processSample(): one input sample in, events out
+    • The is*() query functions
+
+  How it plugs in (CRTP)
+  A button class derives from OptaButtonCore<itself> and provides:
+    • getDebounceMs(), getLongPressMs(), getRepeatStartMs(),
+      getRepeatMinMs(), getAccelRate()   – its timing settings
+    • getDebounceMode()                  – which debounce strategy to run
+    • getRepeatCurve()                   – OptaRepeatCurve table, or nullptr for linear
+    • dispatchEvent(type, now)           – what to do beyond setting the flag
+    • traceRecord(kind, value, now)      – log to a trace recorder, or nothing
+    • learnBounce(edge, now)             – feed an adaptive debounce, or nothing
+  Everything resolves at compile time, so there are no virtual calls.
+
+  RAM layout
+  The state is kept small for AVR boards with 2 KB of SRAM:
+    • The state and event flags are packed into 2 bytes of bitfields
+    • Timestamps are OptaButtonStamp ticks (see OptaButtonClock.h): by
+      default the low 16 bits of millis(). All timing uses (now - stamp) in
+      stamp-width arithmetic, which is wrap-safe for any interval up to 65 s
+      (debounce, long press and repeat are all uint16_t milliseconds anyway)
+  That is 15 bytes per button on AVR, down from 28 (25 with the
+  OPTA_BUTTON_MICROS timebase).
+
+  Debounce strategies (OptaDebounceMode)
+    • IMMEDIATE   – act on the first edge, then ignore the input for
+                    debounceMs (lowest latency; a single spike fires a press)
+    • STABLE      – a change must hold, uninterrupted, for debounceMs before
+                    it counts (latency = debounceMs, spikes are rejected)
+    • INTEGRATOR  – time spent pressed counts up, time released counts down;
+                    press at debounceMs, release back at 0 (rejects spikes
+                    and rides through short dropouts on noisy lines)
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>            // max() and fixed-width integer types
+#include "OptaButtonClock.h"    // OptaButtonStamp ticks, millis() or micros()
+#include "OptaButtonEvents.h"   // OptaButtonEventType
+#include "OptaButtonStats.h"    // optional counters (OPTA_STATS)
+#include "OptaTraceRecorder.h"  // OptaTraceKind
+#include "OptaRepeatCurve.h"    // table-driven repeat acceleration
+
+// How raw input changes are turned into presses and releases
+enum class OptaDebounceMode : uint8_t {
+  IMMEDIATE,   // first edge wins, then lock out for debounceMs (original behaviour)
+  STABLE,      // change must stay put for debounceMs
+  INTEGRATOR,  // integrate pressed/released time up to debounceMs
+};
+
+template <typename Derived>
+class OptaButtonCore {
+public:
+  // ---------- Query Functions ----------
+  bool isShortPressed() const {  // true if just pressed (first ms)
+    return shortPressDetected;
+  }
+  bool isReleased() const {  // true if just released
+    return releaseDetected;
+  }
+  bool isLongPressed() const {  // true if long-press just started
+    return longPressDetected;
+  }
+  bool isLongReleased() const {  // true if long-press just ended
+    return longReleaseDetected;
+  }
+  bool isRepeating() const {  // true for each repeat during hold
+    return repeatTriggered;
+  }
+
+  // How much one repeat should move a value: 1, then 10 and 100 the longer the button is held
+  uint16_t repeatStep() const {
+    return stepLevel == 2 ? 100 : (stepLevel == 1 ? 10 : 1);
+  }
+
+protected:
+  explicit OptaButtonCore(uint16_t repeatStartMs)
+    : currentRepeatInterval(repeatStartMs),  // start repeats at initial interval
+      edgeTime(0),                           // no edge yet
+      lastRepeatTime(0),                     // no repeats yet
+      lastAccelUpdate(0),                    // no accel steps yet
+      lastSampleTime(0),                     // no samples yet
+      filter(0),                             // no candidate / nothing integrated
+      rawState(false),                       // assume not pressed
+      lastSample(false),                     // assume not pressed
+      debouncing(false),                     // not in debounce initially
+      currentPressed(false),                 // debounced state false
+      longPressActive(false),                // long-press not active
+      shortPressDetected(false),             // clear all event flags
+      releaseDetected(false),                //
+      longPressDetected(false),              //
+      longReleaseDetected(false),            //
+      repeatTriggered(false),                //
+      longPressReported(false),              // initialize the guard
+      curveIndex(0),                         // no curve points applied yet
+      stepLevel(0)                           // repeats move values by 1
+  {
+    // Constructor body empty: all initialization done above
+  }
+
+  // Running state shared by every button flavour
+  uint16_t currentRepeatInterval;  // running interval that shrinks
+
+  OptaButtonStamp edgeTime;         // tick when last edge occurred
+  OptaButtonStamp lastRepeatTime;   // tick when last repeat event fired
+  OptaButtonStamp lastAccelUpdate;  // tick when last acceleration step happened
+  OptaButtonStamp lastSampleTime;   // time of the last sample fed to the state machine
+
+  // STABLE: stamp when the candidate change started; INTEGRATOR: integrated ticks (0..debounceMs)
+  OptaButtonStamp filter;
+
+  bool rawState : 1;         // last accepted input (what the debounce settled on)
+  bool lastSample : 1;       // previous raw sample, as fed to processSample()
+  bool debouncing : 1;       // true until debounceTime has passed
+  bool currentPressed : 1;   // egde-triggerd state (true if pressed)
+  bool longPressActive : 1;  // true after longPressDetected until release
+
+  // These flags are cleared each update() then set when events occur
+  bool shortPressDetected : 1;   // set true on press edge
+  bool releaseDetected : 1;      // set true on release edge
+  bool longPressDetected : 1;    // set true when entering long-press
+  bool longReleaseDetected : 1;  // set true when leaving long-press on release
+  bool repeatTriggered : 1;      // set true on each repeat interval
+
+  // Guard so longPressDetected only fires once per physical press
+  bool longPressReported : 1;
+
+  // Repeat curve points already applied during this long press (0..OPTA_REPEAT_CURVE_MAX)
+  uint8_t curveIndex : 5;
+
+  // repeatStep() level: 0 = x1, 1 = x10, 2 = x100; only rises during a hold
+  uint8_t stepLevel : 2;
+
+  // True when released and settled: a "not pressed" sample would change nothing
+  bool isIdle() const {
+    return !rawState && !lastSample && !debouncing && !currentPressed;
+  }
+
+  // How long ago (ticks) the last sample was fed in, for callers replaying older edges
+  OptaButtonStamp ticksSinceLastSample(uint32_t now) const {
+    return OptaButtonStamp(OptaButtonStamp(now) - lastSampleTime);
+  }
+
+  // ---------- clearEvents() ----------
+  void clearEvents() {
+    shortPressDetected = false;   // one-shot flags only live for one update()
+    releaseDetected = false;      //
+    longPressDetected = false;    //
+    longReleaseDetected = false;  //
+    repeatTriggered = false;      //
+  }
+
+  // ---------- emit() ----------
+  void emit(OptaButtonEventType type, uint32_t now) {
+    // Set the matching one-shot flag for the is*() queries
+    switch (type) {
+      case OptaButtonEventType::SHORT_PRESS: shortPressDetected = true; break;
+      case OptaButtonEventType::RELEASE: releaseDetected = true; break;
+      case OptaButtonEventType::LONG_PRESS: longPressDetected = true; break;
+      case OptaButtonEventType::LONG_RELEASE: longReleaseDetected = true; break;
+      case OptaButtonEventType::REPEAT: repeatTriggered = true; break;
+      default: break;  // group-level types have no per-button flag
+    }
+    OPTA_STATS(OptaButtonStats::countEvent(type));                 // per-type event counter
+    self().traceRecord(OptaTraceKind::EVENT, uint8_t(type), now);  // flight recorder, if attached
+    self().dispatchEvent(type, now);                               // queue / callbacks, if the button has any
+  }
+
+  // ---------- acceptEdge() ----------
+  // The debounce has decided the input really changed: update state and fire events
+  void acceptEdge(bool pressed, uint32_t now) {
+    OptaButtonStamp t = OptaButtonStamp(now);  // stamp-width view of the clock for our timers
+    rawState = pressed;                        // remember this new input so we can detect future changes
+    self().traceRecord(OptaTraceKind::DEBOUNCED, pressed, now);  // log what the debounce accepted
+
+    if (pressed) {
+      emit(OptaButtonEventType::SHORT_PRESS, now);        // fire a one‑time “button down” event right now
+      currentPressed = true;                              // immediately update our logical state to “down”
+      longPressActive = false;                            // clear any leftover long‑press status
+      currentRepeatInterval = self().getRepeatStartMs();  // reset the repeat delay back to its initial value
+      stepLevel = 0;                                      // and the repeat step back to 1
+      lastRepeatTime = t;                                 // schedule the first repeat after that start delay
+      lastAccelUpdate = t;                                // start counting from now toward the next speed‑up
+    } else {
+      emit(OptaButtonEventType::RELEASE, now);  // fire a one‑time “button up” event right now
+      if (longPressActive) {                    // if we were in a long‑press, report its end
+        emit(OptaButtonEventType::LONG_RELEASE, now);
+      }
+      currentPressed = false;     // immediately update our logical state to “up”
+      longPressActive = false;    // turn off the long‑press flag so repeats stop
+      longPressReported = false;  // allow the next press to be reported as a long‑press again
+    }
+  }
+
+  // ---------- processSample() ----------
+  void processSample(bool pressed, uint32_t now) {
+    OptaButtonStamp t = OptaButtonStamp(now);                       // stamp-width view of the clock for our timers
+    OptaButtonStamp elapsed = OptaButtonStamp(t - lastSampleTime);  // ticks since the previous sample
+    bool previous = lastSample;                                     // level the input held during that time
+    lastSampleTime = t;                                             // later samples must never be older than this one
+    lastSample = pressed;                                           // remember for the next call
+    if (pressed != previous) self().traceRecord(OptaTraceKind::RAW, pressed, now);  // input moved
+    self().learnBounce(pressed != previous, now);                      // adaptive debounce, if any (may move the window)
+    OptaButtonStamp window = optaButtonTicks(self().getDebounceMs());  // debounce setting for this button
+
+    switch (self().getDebounceMode()) {
+      case OptaDebounceMode::IMMEDIATE:
+        OPTA_STATS(if (debouncing && pressed != previous) OptaButtonStats::countDebounceReject());  // bounce inside the lockout
+        // If state just changed AND we’re not already waiting out a debounce, treat it as a real edge
+        if (pressed != rawState && !debouncing) {
+          debouncing = true;  // starting next loop, pass this logic gate until debounceTime
+          edgeTime = t;       // stamp the exact tick of this transition for timing
+          acceptEdge(pressed, now);
+        }
+
+        // After the debounce window has passed, allow new edges to be detected
+        if (debouncing && (OptaButtonStamp(t - edgeTime) >= window)) {
+          debouncing = false;  // exit debounce, so (pressed != rawState) can fire again
+        }
+        break;
+
+      case OptaDebounceMode::STABLE:
+        OPTA_STATS(if (debouncing && pressed == rawState) OptaButtonStats::countDebounceReject());  // candidate fell back
+        if (pressed == rawState) {                           // input agrees with our state again
+          debouncing = false;                                // any candidate was just a glitch
+        } else if (!debouncing) {                            // a new change is starting
+          debouncing = true;                                 // watch it for debounceMs
+          filter = t;                                        // remember when it started
+        } else if (OptaButtonStamp(t - filter) >= window) {  // it held the whole window
+          debouncing = false;                                // confirmed
+          edgeTime = filter;                                 // hold time counts from the real edge
+          acceptEdge(pressed, now);
+        }
+        break;
+
+      case OptaDebounceMode::INTEGRATOR:
+        OPTA_STATS(if (debouncing && pressed != previous) OptaButtonStats::countDebounceReject());  // reversed before settling
+        // Credit the time since the last sample to the level the input held during it
+        if (previous) {
+          filter = (filter >= window || elapsed >= window - filter) ? window : filter + elapsed;  // count up, cap at window
+        } else {
+          filter = (filter > elapsed) ? filter - elapsed : 0;  // count down, floor at 0
+        }
+        if (pressed && !rawState && filter >= window) {  // integrated all the way up
+          edgeTime = t;                                  // press confirmed now
+          acceptEdge(true, now);
+        } else if (!pressed && rawState && filter == 0) {  // integrated all the way down
+          edgeTime = t;                                    // release confirmed now
+          acceptEdge(false, now);
+        }
+        debouncing = (filter != 0 && filter < window);  // somewhere in between: not settled
+        break;
+    }
+
+    // Once we’re out of debounce AND the button is held down, handle long‑press timing and repeats
+    if (!debouncing && currentPressed) {
+      // Only fire the long‑press event once, when the hold time crosses the threshold
+      if (!longPressReported && (OptaButtonStamp(t - edgeTime) >= optaButtonTicks(self().getLongPressMs()))) {
+        emit(OptaButtonEventType::LONG_PRESS, now);  // report “you’ve held it long enough” this one time
+        longPressActive = true;                      // enter the long‑press state so repeats can happen
+        longPressReported = true;                    // block any further long‑press events until release
+        lastRepeatTime = t;                          // reset repeat timer so the first repeat waits the full interval
+        lastAccelUpdate = t;                         // reset accel timer so we don’t speed up immediately
+        curveIndex = 0;                              // with a curve: start at its first point
+      }
+
+      // With a repeat curve, step through its table as the hold time passes each point
+      const OptaRepeatCurve* curve = self().getRepeatCurve();
+      if (longPressActive && curve) {
+        OptaButtonStamp held = OptaButtonStamp(t - lastAccelUpdate);  // time since the long press
+        while (curveIndex < curve->count && held >= optaButtonTicks(curve->points[curveIndex].holdMs)) {
+          currentRepeatInterval = curve->points[curveIndex].intervalMs;  // next speed from the table
+          curveIndex++;                                                  // and look at the point after it
+        }
+      }
+
+      // If we’re in long‑press mode and the repeat interval has elapsed, fire another repeat
+      if (longPressActive && (OptaButtonStamp(t - lastRepeatTime) >= optaButtonTicks(currentRepeatInterval))) {
+        OptaButtonStamp held = OptaButtonStamp(t - edgeTime);  // time since the press, for repeatStep()
+        if (held >= optaButtonTicks(OPTA_REPEAT_STEP_100_MS)) stepLevel = 2;
+        else if (held >= optaButtonTicks(OPTA_REPEAT_STEP_10_MS) && stepLevel == 0) stepLevel = 1;
+        emit(OptaButtonEventType::REPEAT, now);                    // report a repeat event now
+        lastRepeatTime += optaButtonTicks(currentRepeatInterval);  // schedule the next one at the same interval
+      }
+
+      // Without a curve: once per second during a long‑press, shorten the repeat interval until it hits the minimum
+      if (longPressActive && !curve
+          && (OptaButtonStamp(t - lastAccelUpdate) >= optaButtonTicks(1000))
+          && currentRepeatInterval > self().getRepeatMinMs()) {
+        // subtract our acceleration amount, but never go below the configured minimum
+        currentRepeatInterval = max(
+          int(currentRepeatInterval - self().getAccelRate()),
+          int(self().getRepeatMinMs()));
+        lastAccelUpdate = t;  // reset the 1 s accel timer for the next speed‑up
+      }
+    }
+  }
+
+private:
+  Derived& self() {
+    return static_cast<Derived&>(*this);  // reach the concrete button (CRTP)
+  }
+};
+
+// OptaButtonCore.h
@@ -0,0 +1,60 @@
+/*
+ * OptaButtonEvents.cpp
+ * Fixed-capacity FIFO of button events
+ */
+
+#include "OptaButtonEvents.h"  // include our header
+
+// Constructor implementation
+OptaButtonEventQueue::OptaButtonEventQueue(OptaButtonEvent* storage, uint8_t capacitySize)
+  : events(storage),         // save the array
+    capacity(capacitySize),  // save its size
+    head(0),                 // oldest event would be at index 0
+    count(0),                // nothing queued yet
+    dropped(0)               // nothing lost yet
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- pollEvent() ----------
+bool OptaButtonEventQueue::pollEvent(OptaButtonEvent& event) {
+  if (count == 0) return false;                  // nothing happened since the last poll
+  event = events[head];                          // copy out the oldest event
+  head = (head + 1 == capacity) ? 0 : head + 1;  // step past it (wrap at the end)
+  count--;                                       // one fewer waiting
+  return true;
+}
+
+// ---------- push() ----------
+bool OptaButtonEventQueue::push(const OptaButtonEvent& event) {
+  if (count >= capacity) {             // full: keep the older events
+    if (dropped != 0xFFFF) dropped++;  // count the loss (saturating)
+    return false;
+  }
+  uint16_t tail = uint16_t(head) + count;  // slot just past the newest event
+  if (tail >= capacity) tail -= capacity;  // wrap at the end
+  events[tail] = event;                    // store it
+  count++;                                 // one more waiting
+  return true;
+}
+
+// ---------- clear() ----------
+void OptaButtonEventQueue::clear() {
+  head = 0;   // back to an empty queue
+  count = 0;  //
+}
+
+// ---------- resetDropped() ----------
+void OptaButtonEventQueue::resetDropped() {
+  dropped = 0;
+}
+
+// Query functions
+uint8_t OptaButtonEventQueue::available() const {
+  return count;
+}
+uint16_t OptaButtonEventQueue::getDropped() const {
+  return dropped;
+}
+
+// OptaButtonEvents.cpp
@@ -0,0 +1,100 @@
+/*
+  NAME:
+    OptaButtonEvents — Fixed-size event queue for OptaButton
+
+  Purpose
+  The is*() flags only live until the next update(), and reading them means
+  asking every button every loop even when nothing happened. A queue keeps
+  each event until you take it:
+    • Each event is (button id, event type, timestamp, press id)
+    • Fixed capacity, no heap: you provide the storage
+    • pollEvent() hands back one event at a time, oldest first
+
+  How to Use the Queue
+    1. Declare OptaButtonEventBuffer<16> events;  (16 = how many events it holds)
+    2. In setup(), after begin(): myButton.attachQueue(events, 0);
+       (or myGroup.attachQueue(events); to number a group's buttons 0, 1, 2 ...)
+    3. In loop(), after update(): while (events.pollEvent(ev)) { ... }
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>  // fixed-width integer types
+
+// Everything a button can report
+enum class OptaButtonEventType : uint8_t {
+  SHORT_PRESS,   // same moment as isShortPressed()
+  RELEASE,       // same moment as isReleased()
+  LONG_PRESS,    // same moment as isLongPressed()
+  LONG_RELEASE,  // same moment as isLongReleased()
+  REPEAT,        // same moment as isRepeating()
+  DOUBLE_TAP,    // same moment as isDoubleTapped() (see setMultiTap())
+  TRIPLE_TAP,    // same moment as isTripleTapped()
+  CHORD,         // OptaButtonGroup only: buttonId is the chord's index in setChords()
+  PRESS_BEGIN,   // the debounced press edge, before any tap / chord hold-back (see setGestureEvents())
+  GESTURE,       // what a press turned out to be: gesture says tap, double, triple, hold or chord
+};
+
+// Number of event types above (sizes per-type tables such as callbacks)
+static constexpr uint8_t OPTA_BUTTON_EVENT_TYPES = 10;
+
+// How a press (or a tap sequence) was classified, carried by GESTURE events
+enum class OptaGesture : uint8_t {
+  NONE,        // not a GESTURE event
+  TAP,         // one press, released before the long press
+  DOUBLE_TAP,  // two taps (setMultiTap())
+  TRIPLE_TAP,  // three taps
+  HOLD,        // held until the long press
+  CHORD,       // taken by a chord (OptaButtonGroup::setChords())
+};
+
+// One queued event (9 bytes on AVR)
+struct OptaButtonEvent {
+  uint32_t time;             // tick when it happened: millis(), or micros() with OPTA_BUTTON_MICROS
+  uint8_t buttonId;          // id given to attachQueue()
+  OptaButtonEventType type;  // what happened
+  uint8_t pressId;           // press it belongs to (PRESS_BEGIN and its GESTURE share it; 0 for CHORD)
+  OptaGesture gesture;       // GESTURE events only, NONE otherwise
+  uint8_t step;              // REPEAT events: repeatStep() when it fired (1, 10 or 100); 1 otherwise
+};
+
+class OptaButtonEventQueue {
+public:
+  // ---------- Constructor ----------
+  OptaButtonEventQueue(
+    OptaButtonEvent* storage,  // array of events to use as the queue
+    uint8_t capacity           // how many entries are in that array
+  );                           // end constructor
+
+  bool pollEvent(OptaButtonEvent& event);   // take the oldest event, false if none
+  bool push(const OptaButtonEvent& event);  // add an event, false (and counted) if full
+  void clear();                             // throw away every queued event
+  void resetDropped();                      // start getDropped() from 0 again
+
+  // ---------- Query Functions ----------
+  uint8_t available() const;    // events waiting to be polled
+  uint16_t getDropped() const;  // events lost because the queue was full
+
+private:
+  OptaButtonEvent* const events;  // caller-provided storage
+  const uint8_t capacity;         // size of that storage
+  uint8_t head;                   // index of the oldest event
+  uint8_t count;                  // events currently queued
+  uint16_t dropped;               // overflow counter (saturates)
+};
+
+// A queue that brings its own storage: OptaButtonEventBuffer<16> events;
+template <uint8_t N>
+class OptaButtonEventBuffer : public OptaButtonEventQueue {
+public:
+  OptaButtonEventBuffer()
+    : OptaButtonEventQueue(storage, N)  // hand our array to the queue
+  {
+    // Constructor body empty: all initialization done above
+  }
+
+private:
+  OptaButtonEvent storage[N];  // the events themselves
+};
+
+// OptaButtonEvents.h
@@ -0,0 +1,299 @@
+/*
+ * OptaButtonGroup.cpp
+ * Batch poller implementation: one expansion refresh, one snapshot, N state machines
+ */
+
+#include "OptaButtonGroup.h"     // include our header
+#include "OptaExpansionCache.h"  // shared per-expansion input cache
+#include "OptaEdgeCapture.h"     // wake-up on captured edges
+
+// Constructor implementation
+OptaButtonGroup::OptaButtonGroup(OptaButton* const* buttons, uint8_t count)
+  : members(buttons),                                                           // save the array
+    memberCount(count > OPTA_BUTTON_GROUP_MAX ? OPTA_BUTTON_GROUP_MAX : count),  // never more than the mask holds
+    hasExpansionMembers(false),                                                  // decided in begin()
+    lastUpdateTime(0),                                                           // no scans yet
+    pressedMask(0),                                                              // nothing pressed yet
+    activeInterval(LOOP_INTERVAL_TICKS),                                         // scan as fast as a button would
+    idleInterval(LOOP_INTERVAL_TICKS),                                           // no slow-down until asked
+    idle(false),                                                                 // first scan decides
+    bankDebounce(false),                                                         // per-button debounce only
+    bank(0),                                                                     // every bank bit released
+    eventQueue(nullptr),                                                         // no chord events until attachQueue()
+    chordMasks(nullptr),                                                         // no chords until setChords()
+    chordCount(0),                                                               //
+    chordFired(OPTA_CHORD_NONE),                                                 //
+    chordOpen(false),                                                            //
+    chordWindow(0),                                                              //
+    chordStart(0),                                                               //
+    chordMembers(0),                                                             //
+    chordPressed(0),                                                             //
+    chordLatch(0)                                                                //
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- begin() ----------
+void OptaButtonGroup::begin() {
+  hasExpansionMembers = false;                  // recount every time begin() runs
+  for (uint8_t i = 0; i < memberCount; i++) {  // visit each button
+    members[i]->begin();                        // configure its hardware as usual
+    if (members[i]->inputMode == DefLab::ButtonInputMode::EXP_DIG && !members[i]->provider) {
+      hasExpansionMembers = true;  // remember that scans need the expansion bus
+    }
+  }
+}
+
+// ---------- begin(profile) ----------
+bool OptaButtonGroup::begin(OptaButtonProfile& profile) {
+  begin();                     // hardware first, exactly as without a profile
+  return profile.load(*this);  // then retune in place; a bad block leaves the sketch's values
+}
+
+// ---------- attachQueue() ----------
+void OptaButtonGroup::attachQueue(OptaButtonEventQueue& queue) {
+  eventQueue = &queue;  // chords go here too
+  for (uint8_t i = 0; i < memberCount; i++) {
+    members[i]->attachQueue(queue, i);  // event buttonId matches getButton(i)
+  }
+}
+
+#if OPTA_BUTTON_TRACE
+// ---------- attachTrace() ----------
+void OptaButtonGroup::attachTrace(OptaTraceRecorder& recorder) {
+  for (uint8_t i = 0; i < memberCount; i++) {
+    members[i]->attachTrace(recorder, i);  // record buttonId matches getButton(i)
+  }
+}
+#endif
+
+// ---------- useBankDebounce() ----------
+void OptaButtonGroup::useBankDebounce(bool enable) {
+  bankDebounce = enable;  // takes effect on the next scan
+  bank.reset(0);          // restart from "nothing pressed"
+}
+
+// ---------- setScanIntervals() ----------
+void OptaButtonGroup::setScanIntervals(uint16_t activeMs, uint16_t idleMs) {
+  activeInterval = activeMs ? optaButtonTicks(activeMs) : LOOP_INTERVAL_TICKS;  // fast rate
+  idleInterval = idleMs ? optaButtonTicks(idleMs) : LOOP_INTERVAL_TICKS;        // slow rate
+}
+
+// ---------- setChords() ----------
+void OptaButtonGroup::setChords(const uint32_t* masks, uint8_t count, uint16_t windowMs) {
+  chordMasks = masks;                    // caller keeps the table alive
+  chordCount = masks ? count : 0;        //
+  chordWindow = optaButtonTicks(windowMs);
+  chordMembers = 0;                      // every button that appears in some combo
+  for (uint8_t c = 0; c < chordCount; c++) chordMembers |= masks[c];
+  for (uint8_t i = 0; i < memberCount; i++) {
+    OptaButton& b = *members[i];
+    b.holdShortPress = (chordMembers >> i) & 1UL;  // participants hold their presses back
+    b.flushShortPress(lastUpdateTime);             // nothing stays captured across a table change
+    b.chordConsumed = false;
+  }
+  chordOpen = false;  // start clean
+  chordPressed = 0;
+  chordLatch = 0;
+}
+
+// ---------- clearChords() ----------
+void OptaButtonGroup::clearChords() {
+  setChords(nullptr, 0, 0);  // no table: every press is reported right away
+}
+
+// ---------- update() ----------
+void OptaButtonGroup::update() {
+  // Check the loop timer once for the whole group
+  uint32_t now = optaButtonNow();            // one clock read for every button
+  if (now - lastUpdateTime < scanInterval()  // too soon for the current rate...
+      && !(idle && edgesPending())) {        // ...unless an interrupt woke us, skip
+    clearEvents();                           // flags still only live for one update()
+    return;
+  }
+  scan(now, true);  // edge ages measured against the hardware clock
+}
+
+// ---------- update(nowTicks) ----------
+// The caller owns the timebase and the rate: every call is one scan at nowTicks
+void OptaButtonGroup::update(uint32_t now) {
+  scan(now, false);  // no clock read: edges are placed relative to nowTicks
+}
+
+// ---------- scan() ----------
+void OptaButtonGroup::scan(uint32_t now, bool edgeClock) {
+  clearEvents();         // exactly like OptaButton::update()
+  lastUpdateTime = now;  // mark this scan time
+  OPTA_STATS(uint32_t statsStart = OptaButtonStats::scanBegin());  // scan timing, if enabled
+
+  // Start one expansion scan for the whole group (skipped if no button needs it)
+  if (hasExpansionMembers) {          // only touch the bus if needed
+    OptaExpansionCache::beginScan();  // each expansion is now read once, by whichever button gets there first
+  }
+
+  // Capture every button into the snapshot
+  uint32_t raw = 0;                            // build the new snapshot here
+  for (uint8_t i = 0; i < memberCount; i++) {  // visit each button
+    if (members[i]->readInput()) {             // EXP_DIG reads come from the cache
+      raw |= (1UL << i);                       // set this button's bit
+    }
+  }
+  uint32_t mask = bankDebounce ? bank.update(raw) : raw;  // filter bounce on every bit at once
+  pressedMask = mask;                                     // publish the snapshot
+  bool settled = (mask == raw);                           // bank counters still running = not idle
+
+  // Run every state machine from the snapshot
+  for (uint8_t i = 0; i < memberCount; i++) {
+    OptaButton& b = *members[i];       // shorthand for this button
+    bool pressed = (mask >> i) & 1UL;  // this button's bit
+    if (!pressed && b.isIdle() && !b.isUsingInterrupts()) {
+      continue;  // released and settled: nothing could happen, skip it
+    }
+    b.drainEdges(now, edgeClock);      // ISR-captured edges first (if enabled)
+    b.processSample(pressed, now);     // same logic as OptaButton::update()
+    b.checkTaps(now);                  //
+    if (!b.isIdle()) settled = false;  // still pressed, debouncing or holding
+  }
+  if (chordCount) {
+    updateChords(now);              // decide on held-back presses
+    if (chordOpen) settled = false;  // the window must be watched
+  }
+  idle = settled;  // picks the rate for the next scan
+  OPTA_STATS(OptaButtonStats::scanEnd(statsStart));
+
+  // Pipelined expansions: start on the inputs the next scan will use
+  if (hasExpansionMembers) OptaExpansionCache::service();  // no-op unless setPipelined()
+}
+
+// ---------- updateChords() ----------
+void OptaButtonGroup::updateChords(uint32_t now) {
+  // Which participants are down, and which have a press waiting for our decision
+  uint32_t held = 0, pending = 0;
+  for (uint8_t i = 0; i < memberCount; i++) {
+    if (members[i]->currentPressed) held |= (1UL << i);
+    if (members[i]->shortPending) pending |= (1UL << i);
+  }
+  held &= chordMembers;
+
+  // Until the last chord is fully released, presses are just presses
+  if (chordLatch && (held & chordLatch)) {
+    flushChordPresses(now);
+    return;
+  }
+  chordLatch = 0;
+
+  // The first held-back press opens the window
+  if (!chordOpen) {
+    if (!pending) return;  // nothing to decide
+    chordOpen = true;
+    chordStart = now;
+    chordPressed = 0;
+  }
+  chordPressed |= pending;  // went down inside this window
+  bool expired = (now - chordStart >= chordWindow);
+
+  // Exact match on the held buttons, all of which went down inside the window
+  uint8_t match = OPTA_CHORD_NONE;
+  bool larger = false;  // a bigger combo could still be completed
+  for (uint8_t c = 0; c < chordCount; c++) {
+    uint32_t m = chordMasks[c];
+    if (m == held && !(m & ~chordPressed)) match = c;
+    else if ((m & held) == held && m != held) larger = true;
+  }
+
+  if (match != OPTA_CHORD_NONE && (!larger || expired)) {
+    uint32_t m = chordMasks[match];
+    for (uint8_t i = 0; i < memberCount; i++) {
+      if (!((m >> i) & 1UL)) continue;
+      members[i]->consumeByChord(now);  // the chord replaces this press and what follows until released
+    }
+    flushChordPresses(now);   // anybody else held back was just pressing along
+    chordLatch = m;           // no new chord until these are released
+    chordFired = match;       // getChord() for this scan
+    OPTA_STATS(OptaButtonStats::countEvent(OptaButtonEventType::CHORD));
+    if (eventQueue) {
+      OptaButtonEvent event;
+      event.time = now;
+      event.buttonId = match;  // index into the table
+      event.type = OptaButtonEventType::CHORD;
+      event.pressId = 0;
+      event.gesture = OptaGesture::NONE;
+      event.step = 1;
+      eventQueue->push(event);
+    }
+    return;
+  }
+
+  // Out of time, or everyone released (their presses went out with the release)
+  if (expired || !(pending | held)) flushChordPresses(now);
+}
+
+// ---------- flushChordPresses() ----------
+void OptaButtonGroup::flushChordPresses(uint32_t now) {
+  for (uint8_t i = 0; i < memberCount; i++) {
+    members[i]->flushShortPress(now);  // no-op unless a press is held back
+  }
+  chordOpen = false;  // next held-back press starts a new window
+  chordPressed = 0;
+}
+
+// ---------- clearEvents() ----------
+void OptaButtonGroup::clearEvents() {
+  for (uint8_t i = 0; i < memberCount; i++) {
+    members[i]->clearEvents();  // one-shot flags only live for one scan
+  }
+  chordFired = OPTA_CHORD_NONE;  // and so does a chord
+}
+
+// ---------- scanInterval() ----------
+uint32_t OptaButtonGroup::scanInterval() const {
+  return idle ? idleInterval : activeInterval;
+}
+
+// ---------- edgesPending() ----------
+bool OptaButtonGroup::edgesPending() const {
+  for (uint8_t i = 0; i < memberCount; i++) {
+    if (OptaEdgeCapture::isPending(members[i]->edgeSlot)) return true;  // OPTA_EDGE_NONE is never pending
+  }
+  return false;
+}
+
+// Query functions
+uint32_t OptaButtonGroup::getPressedMask() const {
+  return pressedMask;
+}
+uint32_t OptaButtonGroup::getDebouncedMask() const {
+  uint32_t mask = 0;
+  for (uint8_t i = 0; i < memberCount; i++) {
+    if (members[i]->currentPressed) mask |= (1UL << i);
+  }
+  return mask;
+}
+uint32_t OptaButtonGroup::getLongPressMask() const {
+  uint32_t mask = 0;
+  for (uint8_t i = 0; i < memberCount; i++) {
+    if (members[i]->longPressActive) mask |= (1UL << i);
+  }
+  return mask;
+}
+uint8_t OptaButtonGroup::size() const {
+  return memberCount;
+}
+OptaButton& OptaButtonGroup::getButton(uint8_t i) const {
+  return *members[i];
+}
+bool OptaButtonGroup::isIdle() const {
+  return idle;
+}
+uint8_t OptaButtonGroup::getChord() const {
+  return chordFired;
+}
+uint32_t OptaButtonGroup::msUntilNextScan() const {
+  if (idle && edgesPending()) return 0;                // an interrupt has woken us
+  uint32_t since = optaButtonNow() - lastUpdateTime;  // ticks since the last scan (wrap-safe)
+  uint32_t interval = scanInterval();                 // rate that applies now
+  if (since >= interval) return 0;                    // due already
+  return (interval - since) / OPTA_BUTTON_TICKS_PER_MS;
+}
+
+// OptaButtonGroup.cpp
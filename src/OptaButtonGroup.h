@@ -0,0 +1,132 @@
+/*
+  NAME:
+    OptaButtonGroup — Batch poller for many OptaButton objects
+
+  Purpose
+  Calling update() on 16-24 buttons one by one means every EXP_DIG button
+  walks the expansion slots and talks to the I2C bus on its own. The group
+  does one scan for all of its buttons instead:
+    • Refresh each digital expansion's inputs once
+    • Capture every button's pressed state into one bitmask
+    • Run every button's state machine from that snapshot
+
+  How to Use the Group
+    1. Declare your OptaButton objects as usual
+    2. Put their addresses in an array and hand it to an OptaButtonGroup
+    3. Call group.begin() in setup() instead of each button's begin()
+    4. Call group.update() in loop() instead of each button's update()
+    5. Keep using isShortPressed(), isLongPressed(), isRepeating() on the buttons
+
+  Bank debounce (optional)
+  useBankDebounce() runs the whole snapshot through an OptaBankDebouncer
+  before any button sees it, so bounce is filtered for all buttons with a
+  handful of bitwise operations (an input must hold for 4 scans in a row).
+  Either way, buttons that are released and settled are skipped entirely
+  when their bit reads "not pressed", so idle buttons cost almost nothing.
+
+  Scan scheduler (optional)
+  setScanIntervals() gives the group two scan rates: a fast one while any
+  button is pressed, debouncing or holding, and a slow idle one once every
+  button is released and settled. Buttons using interrupts wake the group
+  out of the idle rate as soon as an edge is captured, and
+  msUntilNextScan() tells the sketch how long it may sleep.
+
+  Chords (optional)
+  setChords() registers a table of button combinations, one bitmask each
+  (bit i = getButton(i)). When every button of a combination goes down
+  within the chord window, the group reports the chord instead of the
+  individual presses:
+    • getChord() returns its table index for one scan (CHORD event in the queue)
+    • The participants' SHORT_PRESS is never reported, nor their LONG_PRESS,
+      REPEAT or LONG_RELEASE while held; RELEASE still is
+    • A participant pressed on its own reports SHORT_PRESS on release or
+      when the window runs out (a window's worth late), whichever is first
+    • A combination that is part of a larger one waits for the window to
+      run out, so the larger one can still be completed
+
+    const uint32_t chords[] = { (1UL << 0) | (1UL << 1), (1UL << 1) | (1UL << 2) };
+    group.setChords(chords, 2, 80);
+    if (group.getChord() == 0) { ... }  // buttons 0 and 1 together
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaButton.h"         // the buttons this group drives
+#include "OptaBankDebouncer.h"  // optional parallel debounce of the snapshot
+#include "OptaButtonProfile.h"  // optional stored timings
+
+// Snapshot is one bit per button, so a group holds at most this many
+static constexpr uint8_t OPTA_BUTTON_GROUP_MAX = 32;
+
+// getChord() when no chord was recognised
+static constexpr uint8_t OPTA_CHORD_NONE = 0xFF;
+
+class OptaButtonGroup {
+public:
+  // ---------- Constructor ----------
+  OptaButtonGroup(
+    OptaButton* const* buttons,  // array of button addresses (must outlive the group)
+    uint8_t count                // how many entries are in that array
+  );                             // end constructor
+
+  void begin();   // call in setup() to begin() every button in the group
+  bool begin(OptaButtonProfile& profile);  // same, then apply stored timings (false = none loaded)
+  void update();  // call in loop() to scan and update every button at once
+  void update(uint32_t nowTicks);  // one scan at a time you supply, no gate, no clock read
+
+  void attachQueue(OptaButtonEventQueue& queue);  // queue every member's events (id = array index) and chords
+#if OPTA_BUTTON_TRACE
+  void attachTrace(OptaTraceRecorder& recorder);  // log every member, id = array index
+#endif
+  void useBankDebounce(bool enable = true);       // debounce all buttons in parallel (4 scans)
+  void setScanIntervals(uint16_t activeMs, uint16_t idleMs);  // 0 = every LOOP_INTERVAL_TICKS
+  void setChords(const uint32_t* masks, uint8_t count, uint16_t windowMs = 80);  // combo table (must outlive the group)
+  void clearChords();                                                           // back to plain presses
+
+  // ---------- Query Functions ----------
+  uint32_t getPressedMask() const;         // bit i = button i read "pressed" in the last scan (after bank debounce)
+  uint32_t getDebouncedMask() const;       // bit i = button i is down after its debounce
+  uint32_t getLongPressMask() const;       // bit i = button i is held past its long press
+  uint8_t size() const;                    // number of buttons in the group
+  OptaButton& getButton(uint8_t i) const;  // access button i (no range check)
+  bool isIdle() const;                     // true if every button was released and settled after the last scan
+  uint32_t msUntilNextScan() const;        // how long update() will keep skipping (0 = scan due now)
+  uint8_t getChord() const;                // chord recognised in the last scan, or OPTA_CHORD_NONE
+
+private:
+  OptaButton* const* members;  // caller-owned array of buttons
+  const uint8_t memberCount;   // clamped to OPTA_BUTTON_GROUP_MAX
+  bool hasExpansionMembers;    // true if any button uses EXP_DIG
+
+  uint32_t lastUpdateTime;  // last tick when a scan ran
+  uint32_t pressedMask;     // snapshot of the last scan
+
+  uint32_t activeInterval;  // ticks between scans while anything is happening
+  uint32_t idleInterval;    // ticks between scans while everything is settled
+  bool idle;                // result of the last scan: every button settled
+
+  uint32_t scanInterval() const;  // the interval that applies right now
+  void clearEvents();             // every member's one-shot flags, and the chord
+  bool edgesPending() const;      // true if an interrupt-driven member has captured an edge
+  void scan(uint32_t now, bool edgeClock);  // one scan of every member (see OptaButton::drainEdges())
+
+  bool bankDebounce;                 // true = snapshot goes through bank first
+  OptaBankDebouncer<uint32_t> bank;  // one vertical counter per button
+
+  // Chord detection (see setChords())
+  OptaButtonEventQueue* eventQueue;  // where CHORD events go, if attached
+  const uint32_t* chordMasks;        // caller-owned combo table
+  uint8_t chordCount;                // entries in that table
+  uint8_t chordFired;                // index recognised this scan, or OPTA_CHORD_NONE
+  bool chordOpen;                    // a participant went down and the window is running
+  uint32_t chordWindow;              // ticks the participants have to all go down
+  uint32_t chordStart;               // tick the window opened
+  uint32_t chordMembers;             // union of every combo
+  uint32_t chordPressed;             // participants that went down inside the open window
+  uint32_t chordLatch;               // last chord fired, until all of its buttons are released
+
+  void updateChords(uint32_t now);           // match the held participants against the table
+  void flushChordPresses(uint32_t now);      // window over: report the held-back presses
+};
+
+// OptaButtonGroup.h
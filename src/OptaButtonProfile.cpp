@@ -0,0 +1,216 @@
+/*
+ * OptaButtonProfile.cpp
+ * Versioned, CRC-checked timing block in EEPROM (AVR) or KVStore (mbed)
+ */
+
+#include "OptaButtonProfile.h"  // include our header
+#include "OptaButtonGroup.h"    // getButton(), size()
+
+#if defined(ARDUINO_ARCH_AVR)
+#include <EEPROM.h>  // byte-wise EEPROM access
+#elif defined(ARDUINO_ARCH_MBED)
+#include <kvstore_global_api.h>  // kv_get() / kv_set() on the internal flash
+#endif
+
+// Bytes per button record, and where the records start
+static constexpr uint8_t RECORD_SIZE = 9;
+static constexpr uint8_t HEADER_SIZE = 4;
+
+#if defined(ARDUINO_ARCH_MBED)
+// KVStore records are only read and written whole, so mbed keeps one block
+// image on the stack during load() / save(). AVR streams the EEPROM instead
+static constexpr uint16_t PROFILE_MAX = optaProfileSize(OPTA_BUTTON_GROUP_MAX);
+#endif
+
+// ---------- crc16() ----------
+// CRC-16/CCITT-FALSE, bit by bit and resumable: a few hundred bytes once at begin() don't need a table
+static uint16_t crc16(uint16_t crc, const uint8_t* data, uint8_t length) {
+  for (uint8_t i = 0; i < length; i++) {
+    crc ^= uint16_t(data[i]) << 8;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? uint16_t((crc << 1) ^ 0x1021) : uint16_t(crc << 1);
+    }
+  }
+  return crc;
+}
+
+// Little-endian helpers for the block
+static void put16(uint8_t* p, uint16_t v) {
+  p[0] = uint8_t(v);
+  p[1] = uint8_t(v >> 8);
+}
+static uint16_t get16(const uint8_t* p) {
+  return uint16_t(p[0] | (p[1] << 8));
+}
+
+// One button's record, in and out
+static void encodeRecord(uint8_t* r, const OptaButtonParams& p) {
+  put16(r, p.debounceMs);
+  put16(r + 2, p.longPressMs);
+  put16(r + 4, p.repeatStartMs);
+  put16(r + 6, p.repeatMinMs);
+  r[8] = p.accelRate;
+}
+static OptaButtonParams decodeRecord(const uint8_t* r) {
+  OptaButtonParams p;
+  p.debounceMs = get16(r);
+  p.longPressMs = get16(r + 2);
+  p.repeatStartMs = get16(r + 4);
+  p.repeatMinMs = get16(r + 6);
+  p.accelRate = r[8];
+  return p;
+}
+
+// Constructor implementation
+OptaButtonProfile::OptaButtonProfile(uint16_t eepromAddress, const char* key)
+  : address(eepromAddress),                // save the EEPROM offset
+    kvKey(key),                            // save the KVStore key
+    status(OptaProfileStatus::NOT_LOADED)  // nothing read yet
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- load() ----------
+bool OptaButtonProfile::load(OptaButtonGroup& group) {
+#if defined(ARDUINO_ARCH_MBED)
+  uint8_t image[PROFILE_MAX];  // the whole KVStore record
+#else
+  uint8_t* image = nullptr;    // EEPROM is read in place
+#endif
+  uint16_t size = optaProfileSize(group.size());
+  if (!openBlock(image, size)) return false;  // status set by openBlock()
+
+  // Header first: blank storage reads all 0xFF
+  uint8_t r[RECORD_SIZE];
+  readBytes(image, 0, r, HEADER_SIZE);
+  if (r[0] == 0xFF && r[1] == 0xFF) {
+    status = OptaProfileStatus::EMPTY;
+    return false;
+  }
+  if (r[0] != 'O' || r[1] != 'B' || r[2] != OPTA_PROFILE_VERSION || r[3] != group.size()) {
+    status = OptaProfileStatus::INVALID;  // another format, or written for a different group
+    return false;
+  }
+
+  // Check the whole block before touching any button, one record at a time
+  uint16_t crc = crc16(0xFFFF, r, HEADER_SIZE);
+  for (uint8_t i = 0; i < group.size(); i++) {
+    readBytes(image, HEADER_SIZE + RECORD_SIZE * i, r, RECORD_SIZE);
+    crc = crc16(crc, r, RECORD_SIZE);
+  }
+  readBytes(image, size - 2, r, 2);
+  if (crc != get16(r)) {
+    status = OptaProfileStatus::CRC_ERROR;  // damaged: keep the compiled-in values
+    return false;
+  }
+
+  // Good block: retune every button in place (setParams() clamps what makes no sense)
+  for (uint8_t i = 0; i < group.size(); i++) {
+    readBytes(image, HEADER_SIZE + RECORD_SIZE * i, r, RECORD_SIZE);
+    group.getButton(i).setParams(decodeRecord(r));
+  }
+  status = OptaProfileStatus::LOADED;
+  return true;
+}
+
+// ---------- save() ----------
+bool OptaButtonProfile::save(const OptaButtonGroup& group) {
+#if defined(ARDUINO_ARCH_MBED)
+  uint8_t image[PROFILE_MAX];  // built here, then stored as one record
+#else
+  uint8_t* image = nullptr;    // EEPROM is written in place
+#endif
+  uint16_t size = optaProfileSize(group.size());
+#if defined(ARDUINO_ARCH_AVR)
+  if (uint32_t(address) + size > EEPROM.length()) return false;  // doesn't fit
+#endif
+
+  uint8_t r[RECORD_SIZE];
+  r[0] = 'O';  // magic
+  r[1] = 'B';  //
+  r[2] = OPTA_PROFILE_VERSION;
+  r[3] = group.size();
+  writeBytes(image, 0, r, HEADER_SIZE);
+  uint16_t crc = crc16(0xFFFF, r, HEADER_SIZE);
+  for (uint8_t i = 0; i < group.size(); i++) {
+    encodeRecord(r, group.getButton(i).getParams());
+    writeBytes(image, HEADER_SIZE + RECORD_SIZE * i, r, RECORD_SIZE);
+    crc = crc16(crc, r, RECORD_SIZE);
+  }
+  put16(r, crc);
+  writeBytes(image, size - 2, r, 2);
+  return commitBlock(image, size);
+}
+
+OptaProfileStatus OptaButtonProfile::getStatus() const {
+  return status;
+}
+
+// ---------- openBlock() ----------
+bool OptaButtonProfile::openBlock(uint8_t* image, uint16_t size) {
+#if defined(ARDUINO_ARCH_AVR)
+  (void)image;
+  if (uint32_t(address) + size > EEPROM.length()) {
+    status = OptaProfileStatus::NO_STORAGE;  // doesn't fit at this address
+    return false;
+  }
+  return true;
+#elif defined(ARDUINO_ARCH_MBED)
+  size_t got = 0;
+  if (kv_get(kvKey, image, size, &got) != MBED_SUCCESS || got == 0) {
+    status = OptaProfileStatus::EMPTY;  // key never written
+    return false;
+  }
+  if (got < size) {
+    status = OptaProfileStatus::INVALID;  // written for a smaller group
+    return false;
+  }
+  return true;
+#else
+  (void)image;
+  (void)size;
+  status = OptaProfileStatus::NO_STORAGE;
+  return false;
+#endif
+}
+
+// ---------- readBytes() ----------
+void OptaButtonProfile::readBytes(const uint8_t* image, uint16_t offset, uint8_t* dst, uint8_t n) const {
+  for (uint8_t i = 0; i < n; i++) {
+#if defined(ARDUINO_ARCH_AVR)
+    (void)image;
+    dst[i] = EEPROM.read(address + offset + i);
+#else
+    dst[i] = image ? image[offset + i] : 0xFF;  // no image: reads like blank storage
+#endif
+  }
+}
+
+// ---------- writeBytes() ----------
+void OptaButtonProfile::writeBytes(uint8_t* image, uint16_t offset, const uint8_t* src, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+#if defined(ARDUINO_ARCH_AVR)
+    (void)image;
+    EEPROM.update(address + offset + i, src[i]);  // only changed bytes wear the cells
+#else
+    if (image) image[offset + i] = src[i];
+#endif
+  }
+}
+
+// ---------- commitBlock() ----------
+bool OptaButtonProfile::commitBlock(const uint8_t* image, uint16_t size) {
+#if defined(ARDUINO_ARCH_AVR)
+  (void)image;
+  (void)size;
+  return true;  // already in the EEPROM
+#elif defined(ARDUINO_ARCH_MBED)
+  return kv_set(kvKey, image, size, 0) == MBED_SUCCESS;  // one flash record
+#else
+  (void)image;
+  (void)size;
+  return false;
+#endif
+}
+
+// OptaButtonProfile.cpp
@@ -0,0 +1,85 @@
+/*
+  NAME:
+    OptaButtonProfile — Per-site button tuning kept in EEPROM / flash
+
+  Purpose
+  Debounce, long-press and repeat timings are set in the sketch, but the
+  right values depend on the switches and cables on site. A profile stores
+  every button's timings for one OptaButtonGroup, so a field technician can
+  retune them without a firmware deploy:
+    • AVR: EEPROM, at an address you choose
+    • Opta (mbed): the KVStore in flash, under a key you choose
+    • Loaded in begin() and applied with the runtime setters (no reinit)
+    • Versioned and CRC-checked: a blank, corrupt or mismatched block is
+      ignored and the sketch's compiled-in values stay
+    • Values are applied through setParams(), which clamps nonsense
+      (0 ms long press, minimum repeat slower than the first, ...)
+    • AVR reads and writes the EEPROM one 9-byte record at a time; the
+      KVStore only takes whole records, so mbed holds the block on the stack
+
+  How to Use
+    OptaButtonProfile profile;          // EEPROM address 0 / key "/kv/optabutton"
+    void setup() {
+      panel.begin(profile);             // begin() every button, then load the profile
+    }
+    // after tuning, e.g. from a service menu:
+    panel.getButton(2).setDebounceMs(35);
+    profile.save(panel);
+
+  Block layout (little-endian)
+    'O' 'B' version count    header
+    9 bytes per button       debounceMs, longPressMs, repeatStartMs, repeatMinMs (2 each), accelRate
+    crc (2)                  CRC-16/CCITT of everything before it
+  That is 6 + 9 x buttons bytes (294 for a full 32-button group).
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaButton.h"  // OptaButtonParams
+
+class OptaButtonGroup;  // the buttons a profile describes
+
+// Current block format; blocks with any other version are ignored
+static constexpr uint8_t OPTA_PROFILE_VERSION = 1;
+
+// Bytes a profile of count buttons occupies
+static constexpr uint16_t optaProfileSize(uint8_t count) {
+  return uint16_t(6 + 9 * count);
+}
+
+// Outcome of the last load()
+enum class OptaProfileStatus : uint8_t {
+  NOT_LOADED,  // load() not called yet
+  LOADED,      // applied to every button
+  EMPTY,       // nothing stored (blank EEPROM / missing key)
+  INVALID,     // wrong magic, version or button count
+  CRC_ERROR,   // the block is damaged
+  NO_STORAGE,  // this board has neither EEPROM nor KVStore
+};
+
+class OptaButtonProfile {
+public:
+  // ---------- Constructor ----------
+  OptaButtonProfile(
+    uint16_t eepromAddress = 0,         // AVR: where the block starts
+    const char* key = "/kv/optabutton"  // Opta: KVStore key (must outlive the profile)
+  );                                    // end constructor
+
+  bool load(OptaButtonGroup& group);        // apply a stored block; false = keep the current values
+  bool save(const OptaButtonGroup& group);  // store every button's current timings
+
+  OptaProfileStatus getStatus() const;  // why the last load() did what it did
+
+private:
+  const uint16_t address;    // EEPROM offset
+  const char* const kvKey;   // KVStore key
+  OptaProfileStatus status;  // last load() result
+
+  // Storage access; image is the mbed block buffer (nullptr on AVR, which streams the EEPROM)
+  bool openBlock(uint8_t* image, uint16_t size);                                        // check / fetch the block
+  void readBytes(const uint8_t* image, uint16_t offset, uint8_t* dst, uint8_t n) const;  // n bytes at offset
+  void writeBytes(uint8_t* image, uint16_t offset, const uint8_t* src, uint8_t n);      //
+  bool commitBlock(const uint8_t* image, uint16_t size);                                // store what was written
+};
+
+// OptaButtonProfile.h
@@ -0,0 +1,104 @@
+/*
+ * OptaButtonStats.cpp
+ * Optional scan / bus / event counters (empty unless OPTA_BUTTON_STATS=1)
+ */
+
+#include "OptaButtonStats.h"  // include our header
+
+#if OPTA_BUTTON_STATS
+
+// Storage for the shared counters
+OptaButtonStatsData OptaButtonStats::data = {};
+uint32_t OptaButtonStats::lastScanUs = 0;  // no scan yet
+bool OptaButtonStats::scanned = false;     // first scan has no gap
+
+// ---------- get() ----------
+const OptaButtonStatsData& OptaButtonStats::get() {
+  return data;
+}
+
+// ---------- reset() ----------
+void OptaButtonStats::reset() {
+  data = OptaButtonStatsData();  // every counter back to 0
+  scanned = false;               // don't count the pause before the next scan as a gap
+}
+
+// ---------- scanBegin() ----------
+uint32_t OptaButtonStats::scanBegin() {
+  uint32_t nowUs = micros();  // start of this scan
+  if (scanned) {
+    uint32_t gap = nowUs - lastScanUs;                     // wrap-safe
+    if (gap > data.scanGapMaxUs) data.scanGapMaxUs = gap;  // a loop that kept us waiting
+  }
+  lastScanUs = nowUs;  // for the next gap
+  scanned = true;
+  return nowUs;
+}
+
+// ---------- scanEnd() ----------
+void OptaButtonStats::scanEnd(uint32_t startUs) {
+  uint32_t us = micros() - startUs;                        // how long the scan took
+  if (data.scans == 0 || us < data.scanMinUs) data.scanMinUs = us;
+  if (us > data.scanMaxUs) data.scanMaxUs = us;
+  data.scanTotalUs += us;
+  data.scans++;
+}
+
+// ---------- expansionRefresh() ----------
+void OptaButtonStats::expansionRefresh(uint32_t us) {
+  if (us > data.expRefreshMaxUs) data.expRefreshMaxUs = us;
+  data.expRefreshTotalUs += us;
+  data.expRefreshes++;
+}
+
+// ---------- print() ----------
+void OptaButtonStats::print(Print& out) {
+  static const char* const eventNames[OPTA_BUTTON_EVENT_TYPES] = {
+    "short", "release", "long", "longRelease", "repeat", "double", "triple", "chord",  // OptaButtonEventType order
+    "pressBegin", "gesture"
+  };
+  uint32_t scans = data.scans ? data.scans : 1;  // avoid dividing by zero
+
+  out.print(F("updates="));
+  out.print(data.scans);
+  out.print(F(" us/update min/avg/max="));
+  out.print(data.scans ? data.scanMinUs : 0);
+  out.print('/');
+  out.print(data.scanTotalUs / scans);
+  out.print('/');
+  out.print(data.scanMaxUs);
+  out.print(F(" maxGapUs="));
+  out.println(data.scanGapMaxUs);
+
+  uint32_t refreshes = data.expRefreshes ? data.expRefreshes : 1;
+  out.print(F("expRefreshes="));
+  out.print(data.expRefreshes);
+  out.print(F(" perUpdate x100="));
+  out.print(data.expRefreshes * 100UL / scans);
+  out.print(F(" us avg/max="));
+  out.print(data.expRefreshTotalUs / refreshes);
+  out.print('/');
+  out.println(data.expRefreshMaxUs);
+
+  out.print(F("readInputs="));
+  out.print(data.readInputs);
+  out.print(F(" debounceRejects="));
+  out.print(data.debounceRejects);
+  out.print(F(" bounceBursts="));
+  out.print(data.bounceBursts);
+  out.print(F(" maxBounceUs="));
+  out.println(data.bounceMaxUs);
+
+  out.print(F("events"));
+  for (uint8_t i = 0; i < OPTA_BUTTON_EVENT_TYPES; i++) {
+    out.print(' ');
+    out.print(eventNames[i]);
+    out.print('=');
+    out.print(data.events[i]);
+  }
+  out.println();
+}
+
+#endif  // OPTA_BUTTON_STATS
+
+// OptaButtonStats.cpp
@@ -0,0 +1,103 @@
+/*
+  NAME:
+    OptaButtonStats — Optional counters for what button handling costs
+
+  Purpose
+  Shows where the time goes, so slow expansion reads and loops that starve
+  the button scan can be proven instead of guessed:
+    • Scan duration (min / max / average micros per update() that ran)
+    • The largest gap between two scans
+    • Expansion bus refreshes: how many, and how long they took
+    • readInput() calls, events fired per type, samples the debounce rejected
+    • Bounce bursts measured by adaptive debounce, and the widest one
+
+  Build with OPTA_BUTTON_STATS=1 to turn it on. Left at 0, every hook
+  compiles to nothing and no RAM is used; print() then only says so.
+
+  A "scan" is one OptaButtonGroup::update() or one stand-alone
+  OptaButton / OptaButtonT update() that got past the loop timer, so
+  without a group the scan figures are per button, not per loop pass;
+  print() labels them "updates" for that reason. All counters are shared
+  by every button in the sketch.
+
+  print() takes any Print, which is how it reaches the DefLab_Common
+  debug output: hand it the stream that output goes to.
+
+  How to Use
+    OptaButtonStats::print(Serial);  // dump to any Print (Serial, a debug stream...)
+    OptaButtonStats::reset();        // start a new measurement window
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>           // micros(), Print
+#include "OptaButtonEvents.h"  // OptaButtonEventType, OPTA_BUTTON_EVENT_TYPES
+
+#ifndef OPTA_BUTTON_STATS
+#define OPTA_BUTTON_STATS 0  // 1 = collect OptaButtonStats (about 60 bytes of RAM, a few us per scan)
+#endif
+
+// Run a statement only when stats are compiled in
+#if OPTA_BUTTON_STATS
+#define OPTA_STATS(statement) statement
+#else
+#define OPTA_STATS(statement) ((void)0)
+#endif
+
+#if OPTA_BUTTON_STATS
+// Everything collected since the last reset()
+struct OptaButtonStatsData {
+  uint32_t scans;              // scans that ran (group updates, stand-alone button updates)
+  uint32_t scanMinUs;          // shortest scan
+  uint32_t scanMaxUs;          // longest scan
+  uint32_t scanTotalUs;        // sum of all scans (for the average)
+  uint32_t scanGapMaxUs;       // longest time from one scan start to the next
+  uint32_t expRefreshes;       // expansion bus reads
+  uint32_t expRefreshMaxUs;    // slowest expansion read
+  uint32_t expRefreshTotalUs;  // sum of all expansion reads
+  uint32_t readInputs;         // readInput() calls
+  uint32_t debounceRejects;    // samples the debounce filtered out
+  uint32_t bounceBursts;       // bursts measured by OptaBounceLearner
+  uint32_t bounceMaxUs;        // widest of them
+  uint32_t events[OPTA_BUTTON_EVENT_TYPES];  // events fired, indexed by OptaButtonEventType
+};
+#endif
+
+class OptaButtonStats {
+public:
+#if OPTA_BUTTON_STATS
+  static const OptaButtonStatsData& get();  // raw counters
+  static void reset();                      // clear every counter
+  static void print(Print& out);            // human-readable dump
+
+  // ---------- Hooks (use through OPTA_STATS) ----------
+  static uint32_t scanBegin();               // call when a scan starts, returns its start time
+  static void scanEnd(uint32_t startUs);     // call when that scan is done
+  static void expansionRefresh(uint32_t us);  // one bus read took this long
+  static void countReadInput() {
+    data.readInputs++;
+  }
+  static void countDebounceReject() {
+    data.debounceRejects++;
+  }
+  static void countBounce(uint32_t us) {
+    data.bounceBursts++;
+    if (us > data.bounceMaxUs) data.bounceMaxUs = us;
+  }
+  static void countEvent(OptaButtonEventType type) {
+    data.events[uint8_t(type)]++;
+  }
+
+private:
+  static OptaButtonStatsData data;  // the counters
+  static uint32_t lastScanUs;       // start of the previous scan (for the gap)
+  static bool scanned;              // false until the first scan, which has no gap
+#else
+  static void reset() {}  // nothing to clear
+  static void print(Print& out) {
+    out.println(F("OptaButtonStats: build with OPTA_BUTTON_STATS=1"));
+  }
+#endif
+};
+
+// OptaButtonStats.h
@@ -0,0 +1,143 @@
+/*
+  NAME:
+    OptaButtonT — OptaButton with its wiring and timing fixed at compile time
+
+  Purpose
+  A normal OptaButton keeps its mode, pin, inversion and timing in RAM and
+  decides how to read the pin on every poll. When all of that is known when
+  you write the sketch, OptaButtonT takes it as template parameters instead:
+    • No RAM spent on settings, only on the running state
+    • The mode switch and the inversion disappear at compile time
+    • On AVR the pin is read straight from its PINx register, not digitalRead()
+
+  It behaves exactly like OptaButton (same state machine, same is*()
+  queries) for GPIO and OPTA_CTL inputs. Use OptaButton for EXP_DIG, event
+  queues, callbacks and interrupt capture.
+
+  How to Use
+    OptaButtonT<ButtonInputMode::GPIO, 2> btnUp("Up");              // defaults for everything else
+    OptaButtonT<ButtonInputMode::GPIO, 3, false, 35> btnDown("Down");  // 35 ms debounce
+    Then call begin() in setup() and update() in loop() as usual.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaButton.h"  // platform control, LOOP_INTERVAL_TICKS, DefLab enums
+
+template <
+  DefLab::ButtonInputMode Mode,  // GPIO or OPTA_CTL
+  uint8_t Pin,                   // Arduino pin number
+  bool Inverted = false,         // true if LOW=pressed instead of HIGH
+  uint16_t DebounceMs = 20,      // ms to ignore bounce after edge
+  uint16_t LongPressMs = 800,    // ms to hold before long press fires
+  uint16_t RepeatStartMs = 100,  // initial delay between repeats
+  uint16_t RepeatMinMs = 8,      // fastest delay when accelerating
+  uint8_t AccelRate = 100,       // how much to speed up per second
+  OptaDebounceMode DebounceMode = OptaDebounceMode::IMMEDIATE,  // how bounce is filtered
+  const OptaRepeatCurve* RepeatCurve = nullptr>                 // table-driven acceleration (nullptr = linear)
+class OptaButtonT
+  : public OptaButtonCore<OptaButtonT<Mode, Pin, Inverted, DebounceMs, LongPressMs, RepeatStartMs, RepeatMinMs, AccelRate, DebounceMode, RepeatCurve>> {
+  static_assert(Mode != DefLab::ButtonInputMode::EXP_DIG, "OptaButtonT reads pins; use OptaButton for EXP_DIG");
+  static_assert(RepeatMinMs <= RepeatStartMs, "RepeatMinMs must not be larger than RepeatStartMs");
+
+  typedef OptaButtonCore<OptaButtonT> Core;  // shorthand for our base
+
+public:
+  // ---------- Constructor ----------
+  explicit OptaButtonT(const char* label = "")  // the label is the only runtime setting
+    : Core(RepeatStartMs),                      // start repeats at initial interval
+#if OPTA_BUTTON_LABELS
+      name(label),  // save label
+#endif
+      lastUpdateTime(0)  // no updates yet
+  {
+    (void)label;  // unused when labels are compiled out
+  }
+
+  void begin() {  // call in setup() to configure the pin
+    pinMode(Pin, Mode == DefLab::ButtonInputMode::GPIO ? INPUT_PULLUP : INPUT);
+  }
+
+  void update() {  // call in loop() to handle timing and events
+    uint32_t now = optaButtonNow();  // read current time (ms or us ticks)
+    if (OptaButtonStamp(now - lastUpdateTime) < LOOP_INTERVAL_TICKS) {
+      this->clearEvents();  // too soon: flags still only live for one update()
+      return;
+    }
+    update(now);
+  }
+
+  void update(uint32_t now) {  // one scan at a time you supply (timer ISR, PLC cycle, simulation)
+    this->clearEvents();   // one-shot flags only live for one update()
+    lastUpdateTime = now;  // mark this update time
+
+    OPTA_STATS(uint32_t statsStart = OptaButtonStats::scanBegin());  // scan timing, if enabled
+    this->processSample(readInput(), now);                           // same state machine as OptaButton
+    OPTA_STATS(OptaButtonStats::scanEnd(statsStart));
+  }
+
+  // ---------- Query Functions ----------
+  const char* getLabel() const {  // return the button name
+#if OPTA_BUTTON_LABELS
+    return name;
+#else
+    return "";  // labels compiled out
+#endif
+  }
+
+  // ---------- Timing Settings (compile-time constants) ----------
+  static constexpr uint16_t getDebounceMs() {
+    return DebounceMs;
+  }
+  static constexpr uint16_t getLongPressMs() {
+    return LongPressMs;
+  }
+  static constexpr uint16_t getRepeatStartMs() {
+    return RepeatStartMs;
+  }
+  static constexpr uint16_t getRepeatMinMs() {
+    return RepeatMinMs;
+  }
+  static constexpr uint8_t getAccelRate() {
+    return AccelRate;
+  }
+  static constexpr OptaDebounceMode getDebounceMode() {
+    return DebounceMode;
+  }
+  static constexpr const OptaRepeatCurve* getRepeatCurve() {
+    return RepeatCurve;
+  }
+
+  // Low-level read with polarity and inversion folded in at compile time
+  static bool readInput() {
+    OPTA_STATS(OptaButtonStats::countReadInput());
+#if defined(ARDUINO_ARCH_AVR)
+    // Read the port register directly: one load and one AND instead of digitalRead()
+    bool high = (*portInputRegister(digitalPinToPort(Pin)) & digitalPinToBitMask(Pin)) != 0;
+#else
+    bool high = (digitalRead(Pin) == HIGH);  // mbed and other cores
+#endif
+    bool raw = (Mode == DefLab::ButtonInputMode::GPIO) ? !high : high;  // GPIO is active-LOW
+    return Inverted ? !raw : raw;                                      // apply inversion if needed
+  }
+
+private:
+#if OPTA_BUTTON_LABELS
+  const char* name;  // label for prints
+#endif
+  OptaButtonStamp lastUpdateTime;  // last tick when update() ran
+
+  void dispatchEvent(OptaButtonEventType, uint32_t) {
+    // Flags only: nothing else to notify
+  }
+  void traceRecord(OptaTraceKind, uint8_t, uint32_t) {
+    // No trace recorder: use OptaButton for that
+  }
+  void learnBounce(bool, uint32_t) {
+    // Fixed debounce: use OptaButton for adaptive debounce
+  }
+
+  friend Core;  // calls dispatchEvent(), traceRecord() and learnBounce()
+};
+
+// OptaButtonT.h
@@ -0,0 +1,117 @@
+/*
+ * OptaButtonThread.cpp
+ * Fixed-period scanner thread and lock-free event hand-over (mbed only)
+ */
+
+#include "OptaButtonThread.h"  // include our header
+#include <new>                 // std::nothrow
+
+#if defined(ARDUINO_ARCH_MBED)
+
+static constexpr uint32_t EVENT_FLAG = 1u;  // "new events in the ring"
+
+// Constructor implementation
+OptaButtonThread::OptaButtonThread(OptaButtonGroup& group, osPriority_t priority)
+  : buttons(group),            // save the group
+    thread(nullptr),           // created by start()
+    threadPriority(priority),  //
+    flags(),                   //
+    bus(),                     //
+    running(false),            // not scanning yet
+    period(1),                 // set by start()
+    staging(),                 //
+    events(),                  //
+    dropped(0)                 // nothing lost yet
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- start() ----------
+bool OptaButtonThread::start(uint16_t periodMs) {
+  if (thread) return false;  // already running
+  thread = new (std::nothrow) rtos::Thread(threadPriority, OPTA_BUTTON_THREAD_STACK);  // a fresh one every start()
+  if (!thread) return false;         // no heap for the thread object
+  period = periodMs ? periodMs : 1;  // never spin
+  buttons.attachQueue(staging);      // the group queues into our private staging buffer
+  running = true;
+  if (thread->start(mbed::callback(this, &OptaButtonThread::run)) != osOK) {
+    running = false;  // no stack for it
+    delete thread;
+    thread = nullptr;
+    return false;
+  }
+  return true;
+}
+
+// ---------- stop() ----------
+void OptaButtonThread::stop() {
+  if (!thread) return;
+  running = false;  // the scanner finishes its current period...
+  thread->join();   // ...and we wait for it
+  delete thread;    // rtos threads run once: start() makes a new one
+  thread = nullptr;
+}
+
+// ---------- run() ----------
+void OptaButtonThread::run() {
+  auto next = rtos::Kernel::Clock::now();  // fixed-rate schedule, no drift
+  while (running) {
+    bus.lock();        // expansion reads must not interleave with the application's
+    buttons.update();  // the whole scan, from this thread only
+    bus.unlock();
+
+    // Hand every event over; the staging queue is ours alone, the ring is SPSC
+    OptaButtonEvent ev;
+    bool any = false;
+    while (staging.pollEvent(ev)) {
+      if (events.push(ev)) any = true;
+      else countDropped(1);  // reader too slow
+    }
+    countDropped(staging.getDropped());  // one scan made more events than staging holds
+    staging.resetDropped();              // counted: start again so it never saturates
+    if (any) flags.set(EVENT_FLAG);  // wake a waiting reader
+
+    next += std::chrono::milliseconds(period);
+    auto now = rtos::Kernel::Clock::now();
+    if (next <= now) next = now + std::chrono::milliseconds(period);  // fell a whole period behind (a long bus hold): resync, no catch-up burst
+    rtos::ThisThread::sleep_until(next);
+  }
+}
+
+// ---------- pollEvent() ----------
+bool OptaButtonThread::pollEvent(OptaButtonEvent& event) {
+  return events.pop(event);  // reader side of the ring
+}
+
+// ---------- waitEvent() ----------
+bool OptaButtonThread::waitEvent(OptaButtonEvent& event, uint32_t timeoutMs) {
+  auto deadline = rtos::Kernel::Clock::now() + std::chrono::milliseconds(timeoutMs);
+  while (!events.pop(event)) {                     // nothing waiting yet
+    auto now = rtos::Kernel::Clock::now();
+    if (now >= deadline) return false;             // timed out
+    flags.wait_any_for(EVENT_FLAG, std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now));  // sleep until a batch
+  }
+  return true;
+}
+
+uint16_t OptaButtonThread::getDropped() const {
+  return dropped;
+}
+
+// ---------- countDropped() ----------
+void OptaButtonThread::countDropped(uint16_t n) {
+  uint16_t total = dropped + n;
+  dropped = (total < n) ? 0xFFFF : total;  // saturate, like the event queues
+}
+
+// ---------- Bus lock ----------
+void OptaButtonThread::lockBus() {
+  bus.lock();
+}
+void OptaButtonThread::unlockBus() {
+  bus.unlock();
+}
+
+#endif  // ARDUINO_ARCH_MBED
+
+// OptaButtonThread.cpp
@@ -0,0 +1,99 @@
+/*
+  NAME:
+    OptaButtonThread — Scan a button group from its own mbed OS thread (Opta only)
+
+  Purpose
+  Polled from loop(), button latency is whatever the Ethernet, Modbus or
+  display work around it costs. On mbed boards (Opta) a dedicated thread
+  can run the scan instead:
+    • A high-priority thread updates one OptaButtonGroup at a fixed period
+    • Every event goes into a lock-free SPSC ring (one writer: the scanner,
+      one reader: your thread), nothing is ever locked on the hot path
+    • An EventFlags bit is set per batch, so application threads can block
+      in waitEvent() instead of polling
+    • A bus mutex serialises expansion I2C traffic between the scanner and
+      any OptaController calls you make elsewhere
+
+  How to Use
+    OptaButtonThread scanner(panel);  // panel is an OptaButtonGroup
+    void setup() {
+      panel.begin();
+      scanner.start(2);  // scan every 2 ms from now on
+    }
+    void loop() {
+      OptaButtonEvent ev;
+      while (scanner.waitEvent(ev, 100)) { ... }  // blocks up to 100 ms
+      scanner.lockBus();                          // only if you touch OptaController here
+      OPTA_UPDATE();
+      scanner.unlockBus();
+    }
+
+  Rules while the thread runs
+    • Only the scanner calls update() on the group and its buttons; read
+      events from the scanner, not the is*() flags (they change under you)
+    • Configure the buttons (callbacks, curves, chords) before start();
+      callbacks run in the scanner thread, so keep them short
+    • All library state a scan touches (expansion cache, edge capture,
+      stats) is then only written by that one thread. Nothing checks this:
+      an update() on any button or group from another thread while the
+      scanner runs is unsafe, even for buttons outside the scanned group
+    • stop() and start() again is fine; the scanner restarts with a new
+      thread and keeps the events it had not handed over yet
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#if defined(ARDUINO_ARCH_MBED)
+
+#include <mbed.h>             // rtos::Thread, EventFlags, Mutex
+#include "OptaButtonGroup.h"  // the group we scan
+#include "OptaSpscRing.h"     // lock-free hand-over to the application
+
+#ifndef OPTA_BUTTON_THREAD_QUEUE
+#define OPTA_BUTTON_THREAD_QUEUE 32  // events buffered for the application (power of two)
+#endif
+#ifndef OPTA_BUTTON_THREAD_STACK
+#define OPTA_BUTTON_THREAD_STACK 2048  // scanner thread stack in bytes (callbacks run on it)
+#endif
+
+class OptaButtonThread {
+public:
+  // ---------- Constructor ----------
+  OptaButtonThread(
+    OptaButtonGroup& group,                        // buttons to scan (begin() it first)
+    osPriority_t priority = osPriorityAboveNormal  // above loop() and most network threads
+  );                                               // end constructor
+
+  bool start(uint16_t periodMs = 1);  // launch the scanner; false if already running (or out of memory)
+  void stop();                        // ask the scanner to finish and wait for it; start() may follow
+
+  // ---------- Events (application side, one reader thread) ----------
+  bool pollEvent(OptaButtonEvent& event);                     // take the oldest event, false if none
+  bool waitEvent(OptaButtonEvent& event, uint32_t timeoutMs);  // block until an event or the timeout
+  uint16_t getDropped() const;                                 // events lost because nobody read them (or too many in one scan)
+
+  // ---------- Bus lock ----------
+  void lockBus();    // hold off the scanner's expansion reads (e.g. around OPTA_UPDATE())
+  void unlockBus();  // let it continue
+
+private:
+  OptaButtonGroup& buttons;  // what we scan
+  rtos::Thread* thread;      // the scanner, nullptr while stopped (an rtos::Thread only starts once)
+  osPriority_t threadPriority;  // for each new scanner thread
+  rtos::EventFlags flags;    // EVENT_FLAG set after each batch
+  rtos::Mutex bus;           // expansion I2C ownership
+  volatile bool running;     // cleared by stop()
+  uint16_t period;           // ms between scans
+
+  OptaButtonEventBuffer<OPTA_BUTTON_THREAD_QUEUE> staging;          // the group's queue, scanner side only
+  OptaSpscRing<OptaButtonEvent, OPTA_BUTTON_THREAD_QUEUE> events;  // scanner -> application
+  volatile uint16_t dropped;                                       // written by the scanner only
+
+  void countDropped(uint16_t n);  // saturating add to dropped
+
+  void run();  // thread body
+};
+
+#endif  // ARDUINO_ARCH_MBED
+
+// OptaButtonThread.h
@@ -0,0 +1,77 @@
+/*
+ * OptaEdgeCapture.cpp
+ * Per-pin CHANGE interrupts pushing timestamped edges into SPSC rings
+ */
+
+#include "OptaEdgeCapture.h"  // include our header
+
+// Storage for the slot table
+OptaEdgeCapture::Ring OptaEdgeCapture::rings[OPTA_EDGE_SLOTS];
+uint8_t OptaEdgeCapture::pins[OPTA_EDGE_SLOTS] = {};
+bool OptaEdgeCapture::inUse[OPTA_EDGE_SLOTS] = {};
+
+// ---------- isr<S>() ----------
+template <uint8_t S>
+void OptaEdgeCapture::isr() {
+  OptaEdgeRecord edge;                         // build the record on the stack
+  edge.timeUs = micros();                      // timestamp first, before anything else
+  edge.level = uint8_t(digitalRead(pins[S]));  // then the level the pin moved to
+  rings[S].push(edge);                         // full ring drops the edge; update() resyncs from the pin
+}
+
+// ---------- isrFor<S>() ----------
+// Walks S = 0, 1, 2 ... at compile time and returns isr<slot> for the matching slot
+template <uint8_t S>
+OptaEdgeCapture::IsrFn OptaEdgeCapture::isrFor(uint8_t slot) {
+  return slot == S ? &isr<S> : isrFor<S + 1>(slot);
+}
+template <>
+OptaEdgeCapture::IsrFn OptaEdgeCapture::isrFor<OPTA_EDGE_SLOTS>(uint8_t) {
+  return nullptr;  // past the last slot
+}
+
+// ---------- attach() ----------
+uint8_t OptaEdgeCapture::attach(uint8_t pin) {
+  int irq = digitalPinToInterrupt(pin);  // which interrupt line this pin drives
+#ifdef NOT_AN_INTERRUPT
+  if (irq == NOT_AN_INTERRUPT) return OPTA_EDGE_NONE;  // AVR: this pin can't interrupt
+#endif
+
+  for (uint8_t s = 0; s < OPTA_EDGE_SLOTS; s++) {  // find a free slot
+    if (inUse[s]) continue;                        // taken by another button
+    inUse[s] = true;                               // claim it
+    pins[s] = pin;                                 // the ISR reads this pin
+    rings[s].clear();                              // start with an empty ring
+    attachInterrupt(irq, isrFor<0>(s), CHANGE);    // both edges, press and release
+    return s;
+  }
+  return OPTA_EDGE_NONE;  // every slot is in use
+}
+
+// ---------- detach() ----------
+void OptaEdgeCapture::detach(uint8_t slot) {
+  if (slot >= OPTA_EDGE_SLOTS || !inUse[slot]) return;  // nothing to undo
+  detachInterrupt(digitalPinToInterrupt(pins[slot]));   // stop the ISR first
+  rings[slot].clear();                                  // drop anything unread
+  inUse[slot] = false;                                  // free the slot
+}
+
+// ---------- pop() ----------
+bool OptaEdgeCapture::pop(uint8_t slot, OptaEdgeRecord& edge) {
+  if (slot >= OPTA_EDGE_SLOTS) return false;  // no capture for this button
+  return rings[slot].pop(edge);               // oldest edge first
+}
+
+// ---------- newest() ----------
+bool OptaEdgeCapture::newest(uint8_t slot, OptaEdgeRecord& edge) {
+  if (slot >= OPTA_EDGE_SLOTS) return false;  // no capture for this button
+  return rings[slot].peekNewest(edge);        // stays queued for pop()
+}
+
+// ---------- isPending() ----------
+bool OptaEdgeCapture::isPending(uint8_t slot) {
+  if (slot >= OPTA_EDGE_SLOTS) return false;  // no capture for this button
+  return !rings[slot].isEmpty();              // the ISR has queued an edge
+}
+
+// OptaEdgeCapture.cpp
@@ -0,0 +1,66 @@
+/*
+  NAME:
+    OptaEdgeCapture — Pin-change interrupts that timestamp every edge
+
+  Purpose
+  A polled button only sees an edge when update() gets around to reading the
+  pin. If loop() stalls on Modbus or Ethernet work, a short tap can come and
+  go unseen, or be timestamped tens of ms late. With edge capture turned on:
+    • A CHANGE interrupt records (level, micros()) the moment the pin moves
+    • Each pin gets its own small SPSC ring, so the ISR never waits
+    • update() drains the ring and feeds every edge, with its real time,
+      through the normal debounce / long-press state machine
+
+  Only GPIO and OPTA_CTL buttons can use this (expansion inputs live on I2C).
+  On AVR only interrupt-capable pins work (e.g. D2/D3 on an Uno).
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>        // attachInterrupt(), micros()
+#include "OptaSpscRing.h"  // lock-free ring between ISR and loop()
+
+// How many pins can capture edges at once, and how many edges each can hold
+#ifndef OPTA_EDGE_SLOTS
+#if defined(ARDUINO_ARCH_AVR)
+#define OPTA_EDGE_SLOTS 4  // Uno has 2 external interrupts, Mega has 6
+#else
+#define OPTA_EDGE_SLOTS 8  // mbed can interrupt on any pin
+#endif
+#endif
+
+#ifndef OPTA_EDGE_RING_SIZE
+#define OPTA_EDGE_RING_SIZE 8  // edges buffered per pin between update() calls (power of two)
+#endif
+
+static constexpr uint8_t OPTA_EDGE_NONE = 0xFF;  // "no capture slot"
+
+// One captured edge (the pin is implied by the slot it was captured in)
+struct OptaEdgeRecord {
+  uint32_t timeUs;  // micros() when the ISR ran
+  uint8_t level;    // digitalRead() value right after the edge
+};
+
+class OptaEdgeCapture {
+public:
+  static uint8_t attach(uint8_t pin);                   // start capturing a pin, returns slot or OPTA_EDGE_NONE
+  static void detach(uint8_t slot);                     // stop capturing and free the slot
+  static bool pop(uint8_t slot, OptaEdgeRecord& edge);  // oldest unread edge of a slot, false if none
+  static bool newest(uint8_t slot, OptaEdgeRecord& edge);  // latest unread edge, left in place; false if none
+  static bool isPending(uint8_t slot);                  // true if the slot holds unread edges
+
+private:
+  typedef void (*IsrFn)();                                          // plain ISR signature
+  typedef OptaSpscRing<OptaEdgeRecord, OPTA_EDGE_RING_SIZE> Ring;  // per-slot buffer type
+
+  template <uint8_t S>
+  static void isr();  // one tiny ISR per slot (AVR ISRs can't take an argument)
+  template <uint8_t S>
+  static IsrFn isrFor(uint8_t slot);  // pick isr<slot> without a hand-written table
+
+  static Ring rings[OPTA_EDGE_SLOTS];    // edges waiting for update()
+  static uint8_t pins[OPTA_EDGE_SLOTS];  // which pin each slot watches
+  static bool inUse[OPTA_EDGE_SLOTS];    // slot ownership
+};
+
+// OptaEdgeCapture.h
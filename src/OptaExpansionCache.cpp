@@ -0,0 +1,140 @@
+/*
+ * OptaExpansionCache.cpp
+ * Per-expansion input cache shared by every EXP_DIG button and group
+ */
+
+#include "OptaExpansionCache.h"  // include our header
+
+// Storage for the shared cache (entries start at generation 0 = never read)
+OptaExpansionCache::Entry OptaExpansionCache::entries[OPTA_EXP_CACHE_SLOTS] = {};
+uint16_t OptaExpansionCache::generation = 1;        // start ahead of the entries so the first read refreshes
+uint8_t OptaExpansionCache::expansionCount = 0xFF;  // unknown until the first topology check
+uint8_t OptaExpansionCache::topologyVersion = 0;    // buttons start out resolved against "unknown"
+bool OptaExpansionCache::pipelined = false;        // refresh inside the scan until setPipelined()
+uint8_t OptaExpansionCache::nextRefresh = 0;        // round robin starts at the first slot
+
+// ---------- beginScan() ----------
+void OptaExpansionCache::beginScan() {
+  generation++;                         // every entry is now one scan old
+  if (generation == 0) generation = 1;  // skip 0 so "never read" stays unique after wrap
+  checkTopology();                      // cheap: OptaController already knows the count
+}
+
+// ---------- getGeneration() ----------
+uint16_t OptaExpansionCache::getGeneration() {
+  return generation;
+}
+
+// ---------- getTopologyVersion() ----------
+uint8_t OptaExpansionCache::getTopologyVersion() {
+  return topologyVersion;
+}
+
+// ---------- checkTopology() ----------
+void OptaExpansionCache::checkTopology() {
+#if OPTA == 1
+  uint8_t count = OptaController.getExpansionNum();  // how many expansions are on the bus now
+  if (count == expansionCount) return;               // unchanged: keep the cached types
+  expansionCount = count;                            // remember for next time
+
+  for (uint8_t i = 0; i < OPTA_EXP_CACHE_SLOTS; i++) {
+    Entry& e = entries[i];                         // this slot's entry
+    switch (OptaController.getExpansionType(i)) {  // ask once, not every poll
+      case EXPANSION_OPTA_DIGITAL_MEC: e.type = SlotType::MECH; break;
+      case EXPANSION_OPTA_DIGITAL_STS: e.type = SlotType::SOLID; break;
+      default: e.type = SlotType::NONE; break;
+    }
+    if (e.type != SlotType::NONE) e.handle = OptaController.getExpansion(i);  // both kinds read inputs the same way
+    e.generation = 0;  // force a fresh read after any change
+  }
+  topologyVersion++;  // tell buttons to resolve their index again
+#endif
+}
+
+// ---------- resolve() ----------
+uint8_t OptaExpansionCache::resolve(uint8_t index) {
+  checkTopology();  // make sure the types are known before we look
+
+  if (index == OPTA_EXP_ANY) {  // "first digital expansion found"
+    for (uint8_t i = 0; i < OPTA_EXP_CACHE_SLOTS; i++) {
+      if (entries[i].type != SlotType::NONE) return i;  // stop after first valid expansion match
+    }
+    return OPTA_EXP_NONE;  // nothing digital on the bus
+  }
+
+  if (index >= OPTA_EXP_CACHE_SLOTS) return OPTA_EXP_NONE;               // no such slot
+  return entries[index].type != SlotType::NONE ? index : OPTA_EXP_NONE;  // only digital slots are readable
+}
+
+// ---------- readInputs() ----------
+uint16_t OptaExpansionCache::readInputs(uint8_t i) {
+  if (i >= OPTA_EXP_CACHE_SLOTS) return 0;  // out of range reads as nothing pressed
+
+  Entry& e = entries[i];                            // this expansion's cache entry
+  e.used = true;                                    // service() keeps this one fresh
+  if (e.generation == generation) return e.inputs;  // already read during this scan
+  if (pipelined) return e.inputs;                   // last completed snapshot; service() refreshes it
+  refresh(i);                                       // classic: read it right now
+  return e.inputs;
+}
+
+// ---------- refresh() ----------
+void OptaExpansionCache::refresh(uint8_t i) {
+  Entry& e = entries[i];  // this expansion's cache entry
+  uint16_t word = 0;      // default to nothing pressed
+#if OPTA == 1
+  OPTA_STATS(uint32_t statsStart = micros());  // time the bus read, if enabled
+  if (e.type != SlotType::NONE) {                       // mechanical or solid-state (handle cached)
+    e.handle.updateDigitalInputs();                     // the one bus transaction for this scan
+    for (uint8_t ch = 0; ch < 16; ch++) {               // then copy every channel
+      if (e.handle.digitalRead(ch)) word |= (1u << ch);  // from the refreshed state
+    }
+  }
+  OPTA_STATS(if (e.type != SlotType::NONE) OptaButtonStats::expansionRefresh(micros() - statsStart));
+#endif
+  e.inputs = word;            // remember the channels
+  e.generation = generation;  // and which scan they belong to
+}
+
+// ---------- setPipelined() ----------
+void OptaExpansionCache::setPipelined(bool enable) {
+  pipelined = enable;  // takes effect on the next read
+}
+
+bool OptaExpansionCache::isPipelined() {
+  return pipelined;
+}
+
+// ---------- isStale() ----------
+bool OptaExpansionCache::isStale(uint8_t i) {
+  const Entry& e = entries[i];
+  return e.used && e.type != SlotType::NONE && e.generation != generation;
+}
+
+// ---------- service() ----------
+bool OptaExpansionCache::service() {
+  if (!pipelined) return false;  // classic mode: readInputs() already did the work
+
+  // One bus transaction per call, continuing where the last call stopped
+  for (uint8_t k = 0; k < OPTA_EXP_CACHE_SLOTS; k++) {
+    uint8_t i = nextRefresh;
+    nextRefresh = (nextRefresh + 1 < OPTA_EXP_CACHE_SLOTS) ? nextRefresh + 1 : 0;
+    if (!isStale(i)) continue;
+    refresh(i);
+    break;
+  }
+
+  // Tell the caller whether another call would still find work
+  for (uint8_t i = 0; i < OPTA_EXP_CACHE_SLOTS; i++) {
+    if (isStale(i)) return true;
+  }
+  return false;
+}
+
+// ---------- readChannel() ----------
+bool OptaExpansionCache::readChannel(uint8_t i, uint8_t channel) {
+  if (i == OPTA_EXP_NONE || channel >= 16) return false;  // unresolved or out of range
+  return (readInputs(i) >> channel) & 1u;                 // pick the channel bit
+}
+
+// OptaExpansionCache.cpp
@@ -0,0 +1,95 @@
+/*
+  NAME:
+    OptaExpansionCache — One read per Opta digital expansion per scan
+
+  Purpose
+  Every EXP_DIG button needs the 16 input channels of its expansion, but the
+  expansion should only be asked for them once per scan. The cache keeps one
+  entry per expansion index:
+    • The expansion type (mechanical, solid-state, or not digital)
+    • Its OptaBlue handle, built once, so a refresh is only the bus read
+    • A generation number (which scan the entry was read in)
+    • The 16 input channels packed into one word
+
+  A "scan" is one pass over your buttons. OptaButtonGroup starts one every
+  update(). Stand-alone buttons start one automatically: when a button comes
+  back for its second read of the same generation, the loop has wrapped
+  around and a new scan begins. That works no matter how fast loop() runs,
+  even several passes inside the same millisecond.
+
+  Pipelined refresh (optional)
+  Normally the first button to need an expansion in a scan waits for the
+  I2C transaction right there, in the middle of update(). setPipelined()
+  splits that in two phases:
+    • Buttons read the last completed snapshot; no bus traffic in the scan
+    • service() refreshes one stale expansion (round robin) and returns
+      true while others still wait. The group calls it once at the end of
+      every update(), and the sketch may call it again wherever it
+      has slack, e.g. between its own work items
+  With one expansion the buttons therefore see inputs one scan old. Each
+  further expansion adds a scan, unless the sketch calls service() more often.
+
+  Topology
+  Expansion types and handles are looked up once and kept. Each new scan
+  asks OptaController how many expansions it sees; only when that number
+  changes are they looked up again and the topology version bumped, which
+  tells buttons to resolve their expansion index again.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaButton.h"  // platform control (OPTA) and OptaBlue on Opta
+
+// One cache entry per possible expansion slot
+#if OPTA == 1
+static constexpr uint8_t OPTA_EXP_CACHE_SLOTS = OPTA_CONTROLLER_MAX_EXPANSION_NUM;
+#else
+static constexpr uint8_t OPTA_EXP_CACHE_SLOTS = 1;  // keeps the arrays legal on AVR
+#endif
+static constexpr uint8_t OPTA_EXP_NONE = 0xFF;  // "no digital expansion found"
+
+class OptaExpansionCache {
+public:
+  static void beginScan();                // start a new scan so every expansion may be read once more
+  static uint16_t getGeneration();        // number of the current scan
+  static uint8_t getTopologyVersion();    // changes whenever expansions are added or removed
+  static uint8_t resolve(uint8_t index);  // digital expansion to read for index (OPTA_EXP_ANY = first)
+  static uint16_t readInputs(uint8_t i);  // 16 channels of expansion i, read at most once per scan
+  static bool readChannel(uint8_t i, uint8_t channel);  // one channel of expansion i, via readInputs()
+
+  static void setPipelined(bool enable);  // true = readInputs() never touches the bus, service() does
+  static bool isPipelined();              // current mode
+  static bool service();                  // pipelined: refresh one stale expansion; true if more are stale
+
+private:
+  // What kind of digital expansion sits in a slot
+  enum class SlotType : uint8_t {
+    NONE,   // empty, or not a digital expansion
+    MECH,   // AFX00005 electromechanical relays
+    SOLID,  // AFX00006 solid-state relays
+  };
+
+  struct Entry {
+    uint16_t generation;  // scan this entry was last read in
+    uint16_t inputs;      // bit n = channel n is HIGH
+    SlotType type;        // resolved once per topology
+    bool used;            // some button reads it (pipelined mode only refreshes these)
+#if OPTA == 1
+    Opta::DigitalExpansion handle;  // resolved with the type; refresh() reuses it
+#endif
+  };
+
+  static Entry entries[OPTA_EXP_CACHE_SLOTS];  // one per expansion index
+  static uint16_t generation;                  // current scan number (0 = never read)
+  static uint8_t expansionCount;               // what OptaController reported last time
+  static uint8_t topologyVersion;              // bumped when expansionCount changes
+  static bool pipelined;                       // split-phase refresh through service()
+  static uint8_t nextRefresh;                  // where service() continues its round robin
+
+  // ---------- Helper Methods ----------
+  static void checkTopology();         // re-resolve slot types if expansions came or went
+  static void refresh(uint8_t i);      // the bus transaction for expansion i
+  static bool isStale(uint8_t i);      // used, digital and not read during this scan
+};
+
+// OptaExpansionCache.h
@@ -0,0 +1,40 @@
+/*
+  NAME:
+    OptaInputProvider — Plug your own input source into OptaButton
+
+  Purpose
+  The built-in modes read a pin (GPIO, OPTA_CTL) or an Opta expansion
+  (EXP_DIG). Anything else can feed a button through this small interface:
+    • A recorded input trace, for reproducible tests and benchmarks
+    • A simulated panel on a desktop build
+    • Port expanders, shift registers, or inputs behind a fieldbus
+
+  A provider answers one question: is channel n active right now? The
+  button applies its own inversion, debounce, long press and repeat on top,
+  exactly as for a pin.
+
+  How to Use
+    class MyInputs : public OptaInputProvider {
+      bool readChannel(uint8_t channel) override { ... }
+    };
+    MyInputs inputs;
+    OptaButton btn(inputs, 3, "Start");  // channel 3 of MyInputs
+
+  begin() is called from every button's begin(), so several buttons can
+  share one provider; keep it safe to call more than once.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>  // fixed-width integer types
+
+class OptaInputProvider {
+public:
+  virtual void begin() {}                         // set up the hardware (may be called once per button)
+  virtual bool readChannel(uint8_t channel) = 0;  // true = active, before the button's inversion
+
+protected:
+  ~OptaInputProvider() {}  // providers are never deleted through this interface
+};
+
+// OptaInputProvider.h
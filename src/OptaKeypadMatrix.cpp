@@ -0,0 +1,109 @@
+/*
+ * OptaKeypadMatrix.cpp
+ * Drive rows, read columns, reject rectangles of pressed keys
+ */
+
+#include "OptaKeypadMatrix.h"  // include our header
+
+// Constructor implementation
+OptaKeypadMatrix::OptaKeypadMatrix(const uint8_t* rowPins, uint8_t rows, const uint8_t* colPins, uint8_t cols,
+                                   bool timeSliced, uint8_t settleUs)
+  : rowPin(rowPins),                                                       // save the pins
+    colPin(colPins),                                                       //
+    rowCount(rows > OPTA_KEYPAD_MAX_ROWS ? OPTA_KEYPAD_MAX_ROWS : rows),  // never more than we hold
+    colCount(cols > OPTA_KEYPAD_MAX_COLS ? OPTA_KEYPAD_MAX_COLS : cols),  //
+    sliced(timeSliced),                                                    // save the scan style
+    settle(settleUs),                                                      // save the settle time
+    nextRow(0),                                                            // start at the top
+    working(),                                                             // nothing pressed
+    keys(),                                                                //
+    readMask(),                                                            // set below
+    ghosting(false),                                                       // clean so far
+    ghostFrames(0)                                                         //
+{
+  memset(readMask, 0xFF, sizeof(readMask));  // the first read starts a scan
+}
+
+// ---------- begin() ----------
+void OptaKeypadMatrix::begin() {
+  for (uint8_t r = 0; r < rowCount; r++) pinMode(rowPin[r], INPUT);         // rows float until scanned
+  for (uint8_t c = 0; c < colCount; c++) pinMode(colPin[c], INPUT_PULLUP);  // columns idle HIGH
+}
+
+// ---------- readChannel() ----------
+bool OptaKeypadMatrix::readChannel(uint8_t key) {
+  uint8_t row = key / (colCount ? colCount : 1);
+  uint8_t col = key - row * colCount;
+  if (row >= rowCount) return false;  // no such key
+  uint8_t bit = uint8_t(1u << col);
+  if (readMask[row] & bit) {  // already read since the last scan: a new one starts
+    scan();
+    memset(readMask, 0, sizeof(readMask));
+  }
+  readMask[row] |= bit;
+  return keys[row] & bit;
+}
+
+// ---------- scan() ----------
+void OptaKeypadMatrix::scan() {
+  if (!sliced) {
+    for (uint8_t r = 0; r < rowCount; r++) working[r] = readRow(r);  // the whole matrix now
+    publish();
+    return;
+  }
+  working[nextRow] = readRow(nextRow);  // one row per scan
+  if (++nextRow >= rowCount) {          // frame complete
+    nextRow = 0;
+    publish();
+  }
+}
+
+// ---------- readRow() ----------
+uint8_t OptaKeypadMatrix::readRow(uint8_t row) {
+  pinMode(rowPin[row], OUTPUT);      // drive just this row...
+  digitalWrite(rowPin[row], LOW);    // ...LOW
+  if (settle) delayMicroseconds(settle);
+  uint8_t bits = 0;
+  for (uint8_t c = 0; c < colCount; c++) {
+    if (digitalRead(colPin[c]) == LOW) bits |= uint8_t(1u << c);  // pulled down through a key
+  }
+  pinMode(rowPin[row], INPUT);  // float it again
+  return bits;
+}
+
+// ---------- publish() ----------
+void OptaKeypadMatrix::publish() {
+  // Two rows sharing two or more pressed columns form a rectangle: any of its corners may be a ghost
+  uint8_t ambiguous[OPTA_KEYPAD_MAX_ROWS] = {};
+  bool found = false;
+  for (uint8_t a = 0; a < rowCount; a++) {
+    for (uint8_t b = a + 1; b < rowCount; b++) {
+      uint8_t shared = working[a] & working[b];
+      if (shared & (shared - 1)) {  // more than one bit set
+        ambiguous[a] |= shared;
+        ambiguous[b] |= shared;
+        found = true;
+      }
+    }
+  }
+
+  // Clear keys update normally; keys on a rectangle keep what they had
+  for (uint8_t r = 0; r < rowCount; r++) {
+    keys[r] = uint8_t((working[r] & ~ambiguous[r]) | (keys[r] & ambiguous[r]));
+  }
+  ghosting = found;
+  if (found && ghostFrames != 0xFFFF) ghostFrames++;  // count it (saturating)
+}
+
+// Query functions
+uint8_t OptaKeypadMatrix::getKeyCount() const {
+  return uint8_t(rowCount * colCount);
+}
+bool OptaKeypadMatrix::isGhosting() const {
+  return ghosting;
+}
+uint16_t OptaKeypadMatrix::getGhostFrames() const {
+  return ghostFrames;
+}
+
+// OptaKeypadMatrix.cpp
@@ -0,0 +1,84 @@
+/*
+  NAME:
+    OptaKeypadMatrix — Row/column keypad scanner with ghost-key rejection
+
+  Purpose
+  A 4x4 keypad has 16 keys on 8 pins. The scanner drives one row at a time
+  and reads all columns, then hands each key to an ordinary OptaButton, so
+  every key gets the same short / long / repeat events as a pin would:
+    • Full mode: all rows in one pass per scan
+    • Time-sliced mode: one row per scan, to bound the cost of each loop;
+      keys then update once every `rows` scans
+    • Ghost rejection: without diodes, three keys on the corners of a
+      rectangle make the fourth corner read pressed as well. When two rows
+      share two or more pressed columns, the keys on those crossings keep
+      their previous state until the rectangle clears, so a phantom key
+      never becomes a press
+
+  Wiring
+    • Rows to rowPins: only the row being scanned is driven LOW, the others
+      float (INPUT), so two keys in one column can't short two outputs
+    • Columns to colPins, with the internal pull-ups (INPUT_PULLUP)
+  Key n is row (n / cols), column (n % cols).
+
+  How to Use
+    const uint8_t rowPins[] = { 2, 3, 4, 5 };
+    const uint8_t colPins[] = { 6, 7, 8, 9 };
+    OptaKeypadMatrix keypad(rowPins, 4, colPins, 4);
+    OptaButton key1(keypad, 0, "1");  // row 0, column 0
+    OptaButton key2(keypad, 1, "2");  // row 0, column 1 ...
+
+  Like the other shared providers, a new scan starts when a key is read a
+  second time, so a group (or one pass over the buttons) scans once.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaInputProvider.h"  // the interface we implement
+
+// Largest matrix (one byte of columns per row)
+static constexpr uint8_t OPTA_KEYPAD_MAX_ROWS = 8;
+static constexpr uint8_t OPTA_KEYPAD_MAX_COLS = 8;
+
+class OptaKeypadMatrix : public OptaInputProvider {
+public:
+  // ---------- Constructor ----------
+  OptaKeypadMatrix(
+    const uint8_t* rowPins,   // row pins (must outlive the keypad)
+    uint8_t rows,             // up to OPTA_KEYPAD_MAX_ROWS
+    const uint8_t* colPins,   // column pins (must outlive the keypad)
+    uint8_t cols,             // up to OPTA_KEYPAD_MAX_COLS
+    bool timeSliced = false,  // true = one row per scan instead of all of them
+    uint8_t settleUs = 5      // wait after driving a row, for long ribbon cables
+  );                          // end constructor
+
+  void begin() override;                   // rows floating, columns with pull-ups
+  bool readChannel(uint8_t key) override;  // key state from the last complete frame
+
+  void scan();  // full mode: every row now; time-sliced: the next row
+
+  // ---------- Query Functions ----------
+  uint8_t getKeyCount() const;      // rows x cols
+  bool isGhosting() const;          // the last frame had a rectangle of pressed keys
+  uint16_t getGhostFrames() const;  // frames with a rectangle so far (saturates)
+
+private:
+  const uint8_t* const rowPin;  // caller-owned pins
+  const uint8_t* const colPin;  //
+  const uint8_t rowCount;       // clamped to OPTA_KEYPAD_MAX_ROWS
+  const uint8_t colCount;       // clamped to OPTA_KEYPAD_MAX_COLS
+  const bool sliced;            // one row per scan
+  const uint8_t settle;         // us after driving a row
+
+  uint8_t nextRow;                         // time-sliced: row the next scan reads
+  uint8_t working[OPTA_KEYPAD_MAX_ROWS];   // rows read so far in this frame (bit = column pressed)
+  uint8_t keys[OPTA_KEYPAD_MAX_ROWS];      // last published frame, ghosts rejected
+  uint8_t readMask[OPTA_KEYPAD_MAX_ROWS];  // keys read since the last scan
+  bool ghosting;                           // last frame had a rectangle
+  uint16_t ghostFrames;                    // counter (saturates)
+
+  uint8_t readRow(uint8_t row);  // drive one row, read every column
+  void publish();                // ghost check, then working -> keys
+};
+
+// OptaKeypadMatrix.h
@@ -0,0 +1,117 @@
+/*
+  NAME:
+    OptaMCP23017 — MCP23017 I2C expanders as one bulk input
+
+  Purpose
+  Each MCP23017 has 16 inputs. Both ports of a chip come back in a single
+  two-byte I2C read, so a scan costs one transaction per chip (1-4 chips =
+  16-64 inputs), not one per button.
+
+  Wiring
+    • SDA / SCL to the board's I2C pins, RESET to VCC
+    • A0-A2 set the address: the chips must use consecutive addresses
+    • Buttons from GPA0-7 / GPB0-7 to GND; the chip's internal pull-ups are
+      switched on by begin() (active-LOW, the default)
+    • External pull-ups, or buttons to VCC with pull-downs: pass pullups and
+      activeLow separately, e.g. OptaMCP23017 keys(0x20, 1, false, Wire, true)
+  Channel 0-7 are GPA0-7 of the first chip, 8-15 its GPB0-7, 16 the next chip's GPA0, ...
+
+  How to Use
+    OptaMCP23017 keys(0x20, 2);          // chips at 0x20 and 0x21 = 32 inputs
+    OptaButton btnStart(keys, 0, "Start");
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Wire.h>           // I2C bus
+#include "OptaBulkInput.h"  // snapshot bookkeeping
+
+class OptaMCP23017 : public OptaBulkInput {
+public:
+  // ---------- Constructor ----------
+  OptaMCP23017(
+    uint8_t address = 0x20,  // I2C address of the first chip
+    uint8_t chips = 1,       // chips at address, address + 1, ... (up to 4)
+    bool pullups = true,     // switch on the internal pull-ups; the polarity follows (on = active-LOW)
+    TwoWire& wire = Wire     // which I2C bus
+  );                         // end constructor
+  OptaMCP23017(
+    uint8_t address,         // same as above...
+    uint8_t chips,           //
+    bool pullups,            //
+    TwoWire& wire,           //
+    bool activeLow           // ...plus the polarity on its own: external pull-ups, or active-HIGH wiring
+  );                         // end constructor
+
+protected:
+  void beginBus() override;                 // Wire.begin(), all pins inputs (with pull-ups)
+  void readBurst(uint8_t* bytes) override;  // GPIOA + GPIOB of every chip
+
+private:
+  const uint8_t firstAddress;  // I2C address of chip 0
+  const uint8_t length;        // chips
+  const bool usePullups;       // pull-ups on in beginBus()
+  const uint8_t released;      // port level with every button released (a missing chip reads as this)
+  TwoWire& bus;                // I2C bus
+
+  // Register addresses (IOCON.BANK = 0, the power-on default: A/B pairs are adjacent)
+  static constexpr uint8_t MCP_IODIRA = 0x00;  // direction, 1 = input
+  static constexpr uint8_t MCP_GPPUA = 0x0C;   // pull-ups, 1 = on
+  static constexpr uint8_t MCP_GPIOA = 0x12;   // port levels
+
+  void writeRegisters(uint8_t address, uint8_t reg, uint8_t a, uint8_t b);  // one register pair
+};
+
+// Defined here, not in a .cpp: only sketches that include this header pull in Wire
+
+// ---------- Constructors ----------
+inline OptaMCP23017::OptaMCP23017(uint8_t address, uint8_t chips, bool pullups, TwoWire& wire)
+  : OptaMCP23017(address, chips, pullups, wire, pullups)  // internal pull-ups mean buttons to GND
+{
+  // Constructor body empty: all initialization done above
+}
+
+inline OptaMCP23017::OptaMCP23017(uint8_t address, uint8_t chips, bool pullups, TwoWire& wire, bool activeLow)
+  : OptaBulkInput(uint8_t((chips > 4 ? 4 : chips) * 16), activeLow),  // 16 channels per chip
+    firstAddress(address),                                            // save the address
+    length(chips > 4 ? 4 : chips),                                    // never more than the snapshot holds
+    usePullups(pullups),                                              // save the pull-up choice
+    released(activeLow ? 0xFF : 0x00),                                // what a port reads with nothing pressed
+    bus(wire)                                                         // save the bus
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- beginBus() ----------
+inline void OptaMCP23017::beginBus() {
+  bus.begin();
+  for (uint8_t c = 0; c < length; c++) {
+    writeRegisters(firstAddress + c, MCP_IODIRA, 0xFF, 0xFF);  // every pin an input
+    uint8_t pu = usePullups ? 0xFF : 0x00;
+    writeRegisters(firstAddress + c, MCP_GPPUA, pu, pu);       // pull-ups as asked
+  }
+}
+
+// ---------- writeRegisters() ----------
+inline void OptaMCP23017::writeRegisters(uint8_t address, uint8_t reg, uint8_t a, uint8_t b) {
+  bus.beginTransmission(address);
+  bus.write(reg);  // register A; the address pointer moves on to B by itself
+  bus.write(a);
+  bus.write(b);
+  bus.endTransmission();
+}
+
+// ---------- readBurst() ----------
+inline void OptaMCP23017::readBurst(uint8_t* bytes) {
+  for (uint8_t c = 0; c < length; c++) {
+    uint8_t address = firstAddress + c;
+    bus.beginTransmission(address);
+    bus.write(MCP_GPIOA);                   // start at port A...
+    bus.endTransmission(false);             // ...repeated start, keep the bus
+    uint8_t got = bus.requestFrom(address, uint8_t(2));  // ...and read A and B in one go
+    bytes[2 * c] = (got >= 1) ? uint8_t(bus.read()) : released;      // GPA0-7, a missing chip reads as all released
+    bytes[2 * c + 1] = (got >= 2) ? uint8_t(bus.read()) : released;  // GPB0-7
+  }
+}
+
+// OptaMCP23017.h
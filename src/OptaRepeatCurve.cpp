@@ -0,0 +1,27 @@
+/*
+ * OptaRepeatCurve.cpp
+ * Storage for the ready-made repeat curves
+ */
+
+#include "OptaRepeatCurve.h"  // include our header
+
+// Interval halves every 250 ms held
+static constexpr OptaRepeatPoint exponentialPoints[] = {
+  { 0, 100 },
+  { 250, 50 },
+  { 500, 25 },
+  { 750, 12 },
+  { 1000, 6 },
+  { 1250, 3 },
+};
+const OptaRepeatCurve OPTA_REPEAT_EXPONENTIAL = optaRepeatCurve(exponentialPoints);
+
+// Three distinct speeds, one second apart
+static constexpr OptaRepeatPoint steppedPoints[] = {
+  { 0, 100 },
+  { 1000, 40 },
+  { 2000, 10 },
+};
+const OptaRepeatCurve OPTA_REPEAT_STEPPED = optaRepeatCurve(steppedPoints);
+
+// OptaRepeatCurve.cpp
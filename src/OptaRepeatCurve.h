@@ -0,0 +1,72 @@
+/*
+  NAME:
+    OptaRepeatCurve — Table-driven hold-repeat acceleration
+
+  Purpose
+  By default a held button speeds up in a linear staircase: once per second
+  the repeat interval shrinks by accelRate ms until it reaches repeatMinMs.
+  For scrolling through large ranges that ramps up too slowly. A repeat
+  curve replaces the staircase with a small table of
+  (time held since the long press → repeat interval) points:
+    • Exponential, stepped, or any shape you like
+    • Evaluated by stepping an index through the table, no arithmetic per scan
+    • Lives in flash/const memory; buttons only keep a pointer
+
+  How to Use
+    constexpr OptaRepeatPoint fastEntryPoints[] = {
+      { 0, 100 },    // from the long press: every 100 ms
+      { 400, 40 },   // after 0.4 s held: every 40 ms
+      { 1000, 10 },  // after 1 s held: every 10 ms
+    };
+    constexpr OptaRepeatCurve fastEntry = optaRepeatCurve(fastEntryPoints);
+    myButton.setRepeatCurve(fastEntry);  // or use OPTA_REPEAT_EXPONENTIAL
+
+  Points must be sorted by holdMs. Before the first point applies, repeats
+  run at repeatStartMs. A curve replaces accelRate and repeatMinMs.
+
+  Repeat step
+  Independently of the curve, repeatStep() tells the sketch how far one
+  repeat should move a value: 1, then 10 once the button has been held
+  OPTA_REPEAT_STEP_10_MS, then 100 after OPTA_REPEAT_STEP_100_MS. Fewer,
+  larger updates sweep a big range with far fewer events.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>  // fixed-width integer types
+
+// repeatStep() thresholds: held this long since the press, one repeat counts x10 / x100
+#ifndef OPTA_REPEAT_STEP_10_MS
+#define OPTA_REPEAT_STEP_10_MS 3000
+#endif
+#ifndef OPTA_REPEAT_STEP_100_MS
+#define OPTA_REPEAT_STEP_100_MS 6000
+#endif
+
+// Most points a curve can have (the index is packed into 5 bits)
+static constexpr uint8_t OPTA_REPEAT_CURVE_MAX = 31;
+
+// From holdMs after the long press on, repeat every intervalMs
+struct OptaRepeatPoint {
+  uint16_t holdMs;      // time held since the long press fired
+  uint16_t intervalMs;  // repeat interval from then on
+};
+
+// A table of points, sorted by holdMs
+struct OptaRepeatCurve {
+  const OptaRepeatPoint* points;  // the table
+  uint8_t count;                  // how many points it has
+};
+
+// Build a curve from a table, counting its points for you
+template <uint8_t N>
+constexpr OptaRepeatCurve optaRepeatCurve(const OptaRepeatPoint (&points)[N]) {
+  static_assert(N >= 1 && N <= OPTA_REPEAT_CURVE_MAX, "a repeat curve needs 1 to 31 points");
+  return OptaRepeatCurve{ points, N };
+}
+
+// Ready-made curves
+extern const OptaRepeatCurve OPTA_REPEAT_EXPONENTIAL;  // interval halves every 250 ms: 100 ms down to 3 ms
+extern const OptaRepeatCurve OPTA_REPEAT_STEPPED;      // 100 ms, then 40 ms after 1 s, then 10 ms after 2 s
+
+// OptaRepeatCurve.h
@@ -0,0 +1,78 @@
+/*
+  NAME:
+    OptaSpscRing — Lock-free single-producer / single-consumer ring buffer
+
+  Purpose
+  Hands small records from one writer to one reader without turning
+  interrupts off, e.g. from a pin-change ISR to loop():
+    • Fixed capacity, no heap
+    • The writer only moves head, the reader only moves tail
+    • Both indexes are one byte, so every access is atomic on AVR and ARM
+
+  Capacity must be a power of two (2, 4, 8 ... 128). When the ring is full
+  push() refuses the new record instead of overwriting an unread one.
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>  // fixed-width integer types
+
+// Stop the compiler from moving memory accesses across this line
+#define OPTA_COMPILER_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+template <typename T, uint8_t N>
+class OptaSpscRing {
+  static_assert(N >= 2 && N <= 128 && (N & (N - 1)) == 0, "OptaSpscRing capacity must be a power of two up to 128");
+
+public:
+  OptaSpscRing()
+    : head(0),  // nothing written yet
+      tail(0)   // nothing read yet
+  {
+    // Constructor body empty: all initialization done above
+  }
+
+  // Writer side (e.g. an ISR): returns false if the ring is full
+  bool push(const T& item) {
+    uint8_t h = head;                          // only the writer changes head
+    if (uint8_t(h - tail) >= N) return false;  // full: keep the unread records
+    buffer[h & (N - 1)] = item;                // store the record first
+    OPTA_COMPILER_BARRIER();                   // ...and make sure it lands before head moves
+    head = h + 1;                              // publish it to the reader
+    return true;
+  }
+
+  // Reader side (e.g. loop()): returns false if the ring is empty
+  bool pop(T& item) {
+    uint8_t t = tail;             // only the reader changes tail
+    if (t == head) return false;  // empty: nothing new
+    item = buffer[t & (N - 1)];   // copy the record out first
+    OPTA_COMPILER_BARRIER();      // ...and make sure the copy is done before tail moves
+    tail = t + 1;                 // give the slot back to the writer
+    return true;
+  }
+
+  // Reader side: copy of the latest record, left in the ring. The writer can't
+  // reuse its slot until the reader pops it, so this is as safe as pop()
+  bool peekNewest(T& item) const {
+    uint8_t h = head;             // snapshot once: later pushes don't matter
+    if (h == tail) return false;  // empty: nothing new
+    item = buffer[uint8_t(h - 1) & (N - 1)];
+    return true;
+  }
+
+  bool isEmpty() const {
+    return head == tail;  // reader has caught up
+  }
+
+  void clear() {
+    tail = head;  // reader side only: drop everything unread
+  }
+
+private:
+  T buffer[N];            // the records themselves
+  volatile uint8_t head;  // next slot to write (free-running, wraps at 256)
+  volatile uint8_t tail;  // next slot to read (free-running, wraps at 256)
+};
+
+// OptaSpscRing.h
@@ -0,0 +1,195 @@
+/*
+ * OptaTraceRecorder.cpp
+ * Delta-varint ring of raw edges, debounced transitions and events
+ */
+
+#include "OptaTraceRecorder.h"  // include our header
+
+// Longest record: header + id + 5-byte varint
+static constexpr uint8_t TRACE_RECORD_MAX = 7;
+
+// Times can step back a little between buttons (replayed edges), so deltas are signed: zigzag them
+static uint32_t zigzag(int32_t delta) {
+  return (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+}
+static int32_t unzigzag(uint32_t z) {
+  return int32_t(z >> 1) ^ -int32_t(z & 1);
+}
+
+// Constructor implementation
+OptaTraceRecorder::OptaTraceRecorder(uint8_t* storage, uint16_t capacitySize)
+  : bytes(storage),          // save the array
+    capacity(capacitySize),  // save its size
+    head(0),                 // nothing written yet
+    used(0),                 // empty
+    baseTime(0),             // set by the first record
+    lastTime(0),             //
+    overwritten(0)           // nothing lost yet
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- record() ----------
+void OptaTraceRecorder::record(OptaTraceKind kind, uint8_t buttonId, uint8_t value, uint32_t now) {
+  if (capacity < TRACE_RECORD_MAX) return;  // too small to hold anything
+  if (used == 0) {                          // first record after clear(): it becomes the base
+    baseTime = now;
+    lastTime = now;
+  }
+
+  // Pack the record into a scratch buffer, no formatting, no branches per bit
+  uint8_t rec[TRACE_RECORD_MAX];
+  uint8_t len = 0;
+  rec[len++] = uint8_t((uint8_t(kind) << 4) | (value & 0x0F));  // what and which level/event
+  rec[len++] = buttonId;                                        // who
+  uint32_t z = zigzag(int32_t(now - lastTime));                 // how long since the previous record
+  while (z >= 0x80) {
+    rec[len++] = uint8_t(z | 0x80);  // 7 bits and "more follows"
+    z >>= 7;
+  }
+  rec[len++] = uint8_t(z);  // last 7 bits
+  lastTime = now;
+
+  // Make room by overwriting the oldest records, then copy in
+  while (capacity - used < len) dropOldest();
+  for (uint8_t i = 0; i < len; i++) {
+    bytes[head] = rec[i];
+    head = (head + 1 == capacity) ? 0 : head + 1;  // wrap at the end
+  }
+  used += len;
+}
+
+// ---------- clear() ----------
+void OptaTraceRecorder::clear() {
+  head = 0;         // start over at the front
+  used = 0;         // nothing held
+  overwritten = 0;  // fresh counter
+}
+
+// ---------- at() ----------
+uint8_t OptaTraceRecorder::at(uint16_t offset) const {
+  uint16_t tail = (head >= used) ? head - used : head + capacity - used;  // oldest byte
+  uint16_t i = tail + offset;                                             // may run past the end...
+  if (i >= capacity) i -= capacity;                                       // ...so wrap
+  return bytes[i];
+}
+
+// ---------- decodeAt() ----------
+uint16_t OptaTraceRecorder::decodeAt(uint16_t pos, uint8_t& header, uint8_t& id, int32_t& delta) const {
+  header = at(pos++);  // kind and value
+  id = at(pos++);      // button id
+  uint32_t z = 0;      // zigzag delta, 7 bits at a time
+  uint8_t shift = 0;
+  uint8_t b;
+  do {
+    b = at(pos++);
+    z |= uint32_t(b & 0x7F) << shift;
+    shift += 7;
+  } while ((b & 0x80) && pos < used);
+  delta = unzigzag(z);
+  return pos;  // first byte of the next record
+}
+
+// ---------- dropOldest() ----------
+void OptaTraceRecorder::dropOldest() {
+  uint8_t header, id;
+  int32_t delta;
+  uint16_t len = decodeAt(0, header, id, delta);  // size of the oldest record
+  baseTime += delta;                              // the next record is now relative to this one's time
+  used -= len;
+  if (overwritten != 0xFFFF) overwritten++;  // count the loss (saturating)
+}
+
+// ---------- dumpBinary() ----------
+void OptaTraceRecorder::dumpBinary(Print& out) const {
+  out.write('O');  // magic
+  out.write('T');  //
+  out.write(1);    // format version
+  for (uint8_t i = 0; i < 4; i++) out.write(uint8_t(baseTime >> (8 * i)));
+  out.write(uint8_t(used));
+  out.write(uint8_t(used >> 8));
+  for (uint16_t i = 0; i < used; i++) out.write(at(i));  // oldest first
+}
+
+// ---------- dumpCsv() ----------
+void OptaTraceRecorder::dumpCsv(Print& out) const {
+  static const char* const kindNames[] = { "raw", "debounced", "event" };  // OptaTraceKind order
+
+  out.println(F("time,button,kind,value"));
+  uint32_t time = baseTime;  // running absolute time
+  uint16_t pos = 0;
+  while (pos < used) {
+    uint8_t header, id;
+    int32_t delta;
+    pos = decodeAt(pos, header, id, delta);
+    time += delta;
+
+    uint8_t kind = header >> 4;
+    out.print(time);
+    out.print(',');
+    out.print(id);
+    out.print(',');
+    out.print(kind < 3 ? kindNames[kind] : "?");
+    out.print(',');
+    out.println(header & 0x0F);
+  }
+}
+
+// Query functions
+uint16_t OptaTraceRecorder::size() const {
+  return used;
+}
+uint16_t OptaTraceRecorder::getOverwritten() const {
+  return overwritten;
+}
+
+// ---------- OptaTraceReader ----------
+OptaTraceReader::OptaTraceReader(const uint8_t* dump, uint16_t dumpLength)
+  : records(nullptr),  // set below once the header checks out
+    length(0),         //
+    pos(0),            //
+    baseTime(0),       //
+    time(0)            //
+{
+  if (dumpLength < 9 || dump[0] != 'O' || dump[1] != 'T' || dump[2] != 1) return;  // not a trace
+  for (uint8_t i = 0; i < 4; i++) baseTime |= uint32_t(dump[3 + i]) << (8 * i);
+  uint16_t n = uint16_t(dump[7] | (dump[8] << 8));  // bytes of records
+  if (n > dumpLength - 9) n = dumpLength - 9;       // truncated dump: read what is there
+  records = dump + 9;
+  length = n;
+  time = baseTime;
+}
+
+bool OptaTraceReader::isValid() const {
+  return records != nullptr;
+}
+
+bool OptaTraceReader::next(OptaTraceRecord& record) {
+  if (!records || pos + 3 > length) return false;  // nothing (complete) left
+  uint8_t header = records[pos++];
+  record.buttonId = records[pos++];
+  uint32_t z = 0;
+  uint8_t shift = 0;
+  uint8_t b;
+  do {
+    b = records[pos++];
+    z |= uint32_t(b & 0x7F) << shift;
+    shift += 7;
+  } while ((b & 0x80) && pos < length);
+  time += unzigzag(z);
+  record.time = time;
+  record.kind = OptaTraceKind(header >> 4);
+  record.value = header & 0x0F;
+  return true;
+}
+
+void OptaTraceReader::rewind() {
+  pos = 0;          // first record
+  time = baseTime;  // and its reference time
+}
+
+uint32_t OptaTraceReader::getBaseTime() const {
+  return baseTime;
+}
+
+// OptaTraceRecorder.cpp
@@ -0,0 +1,118 @@
+/*
+  NAME:
+    OptaTraceRecorder — Flight recorder for button inputs and events
+
+  Purpose
+  When an operator says "the button didn't respond", the recorder shows
+  what the library actually saw. It keeps the most recent history of:
+    • Raw input changes (what the pin or expansion read)
+    • Debounced transitions (what the debounce accepted)
+    • Events fired (short press, release, long press, ...)
+
+  It is meant to stay on in production:
+    • Fixed RAM ring, you provide the storage; no heap
+    • Each record is 3-7 bytes: kind + value, button id, and the time since
+      the previous record as a zigzag varint
+    • Recording only packs bytes; all formatting happens in dumpCsv()
+    • When full, the oldest records are overwritten
+
+  How to Use the Recorder
+    1. Declare OptaTraceBuffer<256> trace;  (256 = bytes of history)
+    2. In setup(), after begin(): myButton.attachTrace(trace, 0);
+       (or myGroup.attachTrace(trace); to number a group's buttons 0, 1, 2 ...)
+    3. When something looks wrong: trace.dumpCsv(Serial);  or  trace.dumpBinary(Serial);
+
+  A binary dump can be pasted back into a sketch as a byte array and read
+  with OptaTraceReader, or replayed through buttons with OptaTraceReplay.
+
+  Binary dump format (all multi-byte values little-endian)
+    'O' 'T' 1          magic and format version
+    baseTime (4)       tick the first record's delta is relative to
+    length (2)         bytes of records that follow
+    records...         header (kind << 4 | value), buttonId, zigzag varint delta
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include <Arduino.h>  // Print, fixed-width integer types
+
+// What a trace record describes
+enum class OptaTraceKind : uint8_t {
+  RAW,        // input sample changed; value = 1 pressed, 0 released
+  DEBOUNCED,  // debounce accepted a change; value = 1 pressed, 0 released
+  EVENT,      // event fired; value = OptaButtonEventType
+};
+
+// One decoded record
+struct OptaTraceRecord {
+  uint32_t time;       // tick it happened at (millis() or micros(), see OptaButtonClock.h)
+  uint8_t buttonId;    // id given to attachTrace()
+  OptaTraceKind kind;  // what it is
+  uint8_t value;       // level or event type
+};
+
+class OptaTraceRecorder {
+public:
+  // ---------- Constructor ----------
+  OptaTraceRecorder(
+    uint8_t* storage,  // bytes to use as the ring
+    uint16_t capacity  // how many bytes are in that array
+  );                   // end constructor
+
+  void record(OptaTraceKind kind, uint8_t buttonId, uint8_t value, uint32_t now);  // hot path
+  void clear();                                                                    // forget everything
+
+  void dumpBinary(Print& out) const;  // compact dump, see the format above
+  void dumpCsv(Print& out) const;     // "time,button,kind,value" per line
+
+  // ---------- Query Functions ----------
+  uint16_t size() const;            // bytes of records held
+  uint16_t getOverwritten() const;  // records lost to make room (saturates)
+
+private:
+  uint8_t* const bytes;     // caller-provided storage
+  const uint16_t capacity;  // size of that storage
+  uint16_t head;            // where the next byte goes
+  uint16_t used;            // bytes of records held
+  uint32_t baseTime;        // time the oldest record's delta is relative to
+  uint32_t lastTime;        // time of the newest record
+  uint16_t overwritten;     // overflow counter (saturates)
+
+  uint8_t at(uint16_t offset) const;  // byte offset bytes after the oldest one
+  uint16_t decodeAt(uint16_t pos, uint8_t& header, uint8_t& id, int32_t& delta) const;  // returns the next pos
+  void dropOldest();                  // free the oldest record
+};
+
+// A recorder that brings its own storage: OptaTraceBuffer<256> trace;
+template <uint16_t N>
+class OptaTraceBuffer : public OptaTraceRecorder {
+public:
+  OptaTraceBuffer()
+    : OptaTraceRecorder(storage, N)  // hand our array to the recorder
+  {
+    // Constructor body empty: all initialization done above
+  }
+
+private:
+  uint8_t storage[N];  // the records themselves
+};
+
+// Walks the records of a binary dump, oldest first
+class OptaTraceReader {
+public:
+  OptaTraceReader(const uint8_t* dump, uint16_t length);  // a whole dumpBinary() output
+
+  bool isValid() const;                // false if the header is missing or wrong
+  bool next(OptaTraceRecord& record);  // decode the next record, false at the end
+  void rewind();                       // back to the first record
+  uint32_t getBaseTime() const;        // tick the recording started from
+
+private:
+  const uint8_t* records;  // first record byte
+  uint16_t length;         // bytes of records
+  uint16_t pos;            // next byte to decode
+  uint32_t baseTime;       // from the header
+  uint32_t time;           // running absolute time
+};
+
+// OptaTraceRecorder.h
@@ -0,0 +1,60 @@
+/*
+ * OptaTraceReplay.cpp
+ * Input provider that plays back the RAW records of a trace dump
+ */
+
+#include "OptaTraceReplay.h"  // include our header
+#include "OptaButtonClock.h"  // optaButtonNow()
+
+// Constructor implementation
+OptaTraceReplay::OptaTraceReplay(const uint8_t* dump, uint16_t length)
+  : reader(dump, length),  // parse the header now
+    pending(),             // read on start
+    hasPending(false),     //
+    started(false),        // waiting for begin()
+    origin(0),             //
+    levels(0)              // everything released
+{
+  // Constructor body empty: all initialization done above
+}
+
+// ---------- begin() ----------
+void OptaTraceReplay::begin() {
+  if (started) return;  // several buttons share us: only the first begin() counts
+  started = true;
+  origin = optaButtonNow();           // trace base time maps to now
+  reader.rewind();                    // first record
+  levels = 0;                         // everything released
+  hasPending = reader.next(pending);  // look ahead one record
+}
+
+// ---------- restart() ----------
+void OptaTraceReplay::restart() {
+  started = false;  // the next begin() or read starts over
+}
+
+// ---------- readChannel() ----------
+bool OptaTraceReplay::readChannel(uint8_t channel) {
+  if (!started) begin();  // read before begin(): start now
+  advance();              // catch up to the current time
+  return channel < 32 && ((levels >> channel) & 1UL);
+}
+
+// ---------- advance() ----------
+void OptaTraceReplay::advance() {
+  uint32_t elapsed = optaButtonNow() - origin;  // ticks into the replay (wrap-safe)
+  while (hasPending && int32_t(pending.time - reader.getBaseTime() - elapsed) <= 0) {  // due (or overdue)
+    if (pending.kind == OptaTraceKind::RAW && pending.buttonId < 32) {
+      uint32_t bit = 1UL << pending.buttonId;
+      levels = pending.value ? (levels | bit) : (levels & ~bit);  // apply the recorded level
+    }
+    hasPending = reader.next(pending);  // look ahead again
+  }
+}
+
+// ---------- isFinished() ----------
+bool OptaTraceReplay::isFinished() const {
+  return started && !hasPending;
+}
+
+// OptaTraceReplay.cpp
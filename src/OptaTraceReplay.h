@@ -0,0 +1,48 @@
+/*
+  NAME:
+    OptaTraceReplay — Feed a recorded trace back through buttons
+
+  Purpose
+  Turns the raw-input records of an OptaTraceRecorder binary dump back into
+  inputs, so a field recording can be replayed on the bench or in a
+  simulation (see optaButtonUseClock()) and the debounced transitions and
+  events compared against what was recorded.
+
+  Channel n replays the RAW records of button id n. Recorded levels are
+  "pressed", after each button's polarity and inversion, so build the replay
+  buttons with inverted = false. Trace time starts at the first begin():
+  a record made t ticks after the trace's base time is replayed t ticks
+  after that.
+
+  How to Use
+    const uint8_t dump[] = { 'O', 'T', 1, ... };   // from dumpBinary()
+    OptaTraceReplay replay(dump, sizeof(dump));
+    OptaButton btn(replay, 0, "Replayed");          // button id 0 of the trace
+*/
+
+#pragma once  // guard against multiple inclusion
+
+#include "OptaInputProvider.h"  // the interface we implement
+#include "OptaTraceRecorder.h"  // OptaTraceReader
+
+class OptaTraceReplay : public OptaInputProvider {
+public:
+  OptaTraceReplay(const uint8_t* dump, uint16_t length);  // a whole dumpBinary() output
+
+  void begin() override;                       // first call starts the replay clock
+  bool readChannel(uint8_t channel) override;  // level of that button id at the current time
+  void restart();                              // replay from the beginning at the next begin()/read
+  bool isFinished() const;                     // true once every record has been replayed
+
+private:
+  OptaTraceReader reader;   // walks the dump
+  OptaTraceRecord pending;  // next record, not yet due
+  bool hasPending;          // false once the reader is exhausted
+  bool started;             // replay clock running
+  uint32_t origin;          // optaButtonNow() when the replay started
+  uint32_t levels;          // bit n = current level of button id n (ids 0..31)
+
+  void advance();  // apply every record that is due
+};
+
+// OptaTraceReplay.h